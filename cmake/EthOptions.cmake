@@ -14,6 +14,7 @@ macro(configure_project)
     option(PARANOID "Enable additional checks when validating transactions (deprecated)" OFF)
     option(MINIUPNPC "Build with UPnP support" OFF)
     option(FASTCTEST "Enable fast ctest" OFF)
+    option(FUZZPROFILE "Enable scoped cycle timers in the fuzzer" OFF)
 
     if(MINIUPNPC)
         message(WARNING
@@ -50,6 +51,10 @@ macro(configure_project)
         add_definitions(-DETH_VMTRACE)
     endif ()
 
+    if (FUZZPROFILE)
+        add_definitions(-DFUZZ_PROFILE)
+    endif ()
+
     # CI Builds should provide (for user builds this is totally optional)
     # -DBUILD_NUMBER - A number to identify the current build with. Becomes TWEAK component of project version.
     # -DVERSION_SUFFIX - A string to append to the end of the version string where applicable.
@@ -84,6 +89,7 @@ macro(print_config)
     message("-- DB               Database implementation                  LEVELDB")
     message("-- PARANOID         -                                        ${PARANOID}")
     message("-- MINIUPNPC        -                                        ${MINIUPNPC}")
+    message("-- FUZZPROFILE      Fuzzer per-exec cycle timers             ${FUZZPROFILE}")
     message("------------------------------------------------------------- components")
     message("-- TESTS            Build tests                              ${TESTS}")
     message("-- TOOLS            Build tools                              ${TOOLS}")
@@ -4,7 +4,11 @@
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/program_options.hpp>
 #include <boost/filesystem.hpp>
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
 #include <libfuzzer/Fuzzer.h>
+#include <libfuzzer/CombinedJson.h>
 
 using namespace std;
 using namespace fuzzer;
@@ -12,58 +16,31 @@ using namespace boost::filesystem;
 namespace pt = boost::property_tree;
 namespace po = boost::program_options;
 
+/* Parsed contracts are cached next to the json, keyed by the hash of its content */
 ContractInfo parseJson(string jsonFile, string contractName, bool isMain) {
-  std::ifstream file(jsonFile);
+  std::ifstream file(jsonFile, ios::binary);
   if (!file.is_open()) {
     stringstream output;
     output << "[x] File " + jsonFile + " is not found" << endl;
     cout << output.str();
     exit(0);
   }
-  pt::ptree root;
-  pt::read_json(jsonFile, root);
-  string fullContractName = "";
-  for (auto key : root.get_child("contracts")) {
-    if (boost::ends_with(key.first, contractName)) {
-      fullContractName = key.first;
-      break;
-    }
-  }
-  if (!fullContractName.length()) {
-    cout << "[x] No contract " << contractName << endl;
-    exit(0);
-  }
-  pt::ptree::path_type abiPath("contracts|"+ fullContractName +"|abi", '|');
-  pt::ptree::path_type binPath("contracts|"+ fullContractName +"|bin", '|');
-  pt::ptree::path_type binRuntimePath("contracts|" + fullContractName + "|bin-runtime", '|');
-  pt::ptree::path_type srcmapPath("contracts|" + fullContractName + "|srcmap", '|');
-  pt::ptree::path_type srcmapRuntimePath("contracts|" + fullContractName + "|srcmap-runtime", '|');
+  std::string json((std::istreambuf_iterator<char>(file)), (std::istreambuf_iterator<char>()));
+  auto hash = hashBytes((const byte *) json.data(), json.size());
+  auto cacheFile = jsonFile + ".cache";
   ContractInfo contractInfo;
-  contractInfo.isMain = isMain;
-  contractInfo.abiJson = root.get<string>(abiPath);
-  contractInfo.bin = root.get<string>(binPath);
-  contractInfo.binRuntime = root.get<string>(binRuntimePath);
-  contractInfo.srcmap = root.get<string>(srcmapPath);
-  contractInfo.srcmapRuntime = root.get<string>(srcmapRuntimePath);
-  contractInfo.contractName = fullContractName;
-  for (auto it : root.get_child("sources")) {
-    auto ast = it.second.get_child("AST");
-    vector<pt::ptree> stack = {ast};
-    while (stack.size() > 0) {
-      auto item = stack[stack.size() - 1];
-      stack.pop_back();
-      if (item.get<string>("name") == "FunctionDefinition") {
-        if (item.get<bool>("attributes.constant")) {
-          contractInfo.constantFunctionSrcmap.push_back(item.get<string>("src"));
-        }
-      }
-      if (item.get_child_optional("children")) {
-        for (auto it : item.get_child("children")) {
-          stack.push_back(it.second);
-        }
-      }
+  if (!loadContractCache(cacheFile, hash, contractName, contractInfo)) {
+    if (!CombinedJson(json).read(contractName, contractInfo)) {
+      cout << "[x] File " << jsonFile << " is not a valid combined json" << endl;
+      exit(0);
     }
+    if (!contractInfo.contractName.length()) {
+      cout << "[x] No contract " << contractName << endl;
+      exit(0);
+    }
+    saveContractCache(cacheFile, hash, contractName, contractInfo);
   }
+  contractInfo.isMain = isMain;
   return contractInfo;
 }
 
@@ -81,6 +58,32 @@ ContractInfo parseSource(string sourceFile, string jsonFile, string contractName
   return contractInfo;
 }
 
+/* Init code returning the runtime code which follows it: PUSH2 size DUP1 PUSH1 12 PUSH1 0 CODECOPY PUSH1 0 RETURN */
+string deployerOf(string binRuntime) {
+  auto size = binRuntime.size() / 2;
+  bytes deployer = { 0x61, (byte) (size >> 8), (byte) size, 0x80, 0x60, 0x0c, 0x60, 0x00, 0x39, 0x60, 0x00, 0xf3 };
+  return toHex(deployer);
+}
+
+/* Contract known only by its runtime bytecode and ABI, it has no source map */
+ContractInfo parseBytecode(string binFile, string abiFile, string contractName, bool isMain) {
+  std::ifstream bin(binFile);
+  std::ifstream abi(abiFile);
+  if (!bin.is_open() || !abi.is_open()) {
+    cout << "[x] File " + binFile + " or " + abiFile + " is not found" << endl;
+    exit(0);
+  }
+  std::string binRuntime((std::istreambuf_iterator<char>(bin)), (std::istreambuf_iterator<char>()));
+  boost::trim(binRuntime);
+  if (boost::starts_with(binRuntime, "0x")) binRuntime = binRuntime.substr(2);
+  ContractInfo contractInfo;
+  contractInfo.isMain = isMain;
+  contractInfo.abiJson = std::string((std::istreambuf_iterator<char>(abi)), (std::istreambuf_iterator<char>()));
+  contractInfo.binRuntime = binRuntime;
+  contractInfo.bin = deployerOf(binRuntime) + binRuntime;
+  contractInfo.contractName = contractName;
+  return contractInfo;
+}
 
 string toContractName(directory_entry file) {
   string filePath = file.path().string();
@@ -114,7 +117,7 @@ string compileSolFiles(string folder) {
   return ret.str();
 }
 
-string fuzzJsonFiles(string contracts, string assets, int duration, int mode, int reporter, string attackerName) {
+string fuzzJsonFiles(string contracts, string assets, int duration, int mode, int reporter, string attackerName, int plateau, uint64_t gasBudget, uint64_t stepLimit, size_t batchSize, size_t threads, string objective, string attackerStrategy) {
   stringstream ret;
   unordered_set<string> contractNames;
   /* search for sol file */
@@ -131,6 +134,13 @@ string fuzzJsonFiles(string contracts, string assets, int duration, int mode, in
     ret << " --mode " + to_string(mode);
     ret << " --reporter " + to_string(reporter);
     ret << " --attacker " + attackerName;
+    ret << " --plateau " + to_string(plateau);
+    ret << " --gas-budget " + to_string(gasBudget);
+    ret << " --step-limit " + to_string(stepLimit);
+    ret << " --batch-size " + to_string(batchSize);
+    ret << " --threads " + to_string(threads);
+    ret << " --objective " + objective;
+    ret << " --attacker-strategy " + attackerStrategy;
     ret << endl;
   });
   return ret.str();
@@ -147,6 +157,50 @@ vector<ContractInfo> parseAssets(string assets) {
   return ls;
 }
 
+/*
+ * Fuzz every <name>.bin-runtime of folder with its <name>.abi, jobs contracts at a time.
+ * Each contract runs in a child forked from this process, which already parsed the genesis.
+ * A child writes its stats to <name>.log instead of sharing the terminal with the others
+ */
+void scanBytecodes(string folder, size_t jobs, function<void (ContractInfo)> fuzz) {
+  TargetProgram::chainParams();
+  size_t running = 0;
+  forEachFile(folder, ".bin-runtime", [&](directory_entry file) {
+    auto binFile = file.path().string();
+    auto abiFile = binFile.substr(0, binFile.size() - string(".bin-runtime").size()) + ".abi";
+    auto contractName = toContractName(file);
+    if (running == max(jobs, (size_t) 1)) {
+      wait(nullptr);
+      running --;
+    }
+    /* Nothing buffered before the fork is printed twice */
+    cout.flush();
+    auto pid = fork();
+    /* Out of processes, retry once a running contract is done */
+    while (pid < 0 && running) {
+      wait(nullptr);
+      running --;
+      pid = fork();
+    }
+    if (pid < 0) {
+      cout << "[x] Can not fork to scan " << contractName << ", skipped" << endl;
+      return;
+    }
+    if (pid == 0) {
+      auto log = open((contractName + ".log").c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if (log >= 0) {
+        dup2(log, STDOUT_FILENO);
+        close(log);
+      }
+      fuzz(parseBytecode(binFile, abiFile, contractName, true));
+      cout.flush();
+      _exit(0);
+    }
+    running ++;
+  });
+  while (running --) wait(nullptr);
+}
+
 void showHelp(po::options_description desc) {
   stringstream output;
   output << desc << endl;
@@ -9,9 +9,19 @@ static int DEFAULT_MODE = AFL;
 static int DEFAULT_DURATION = 120; // 2 mins
 static int DEFAULT_REPORTER = JSON;
 static int DEFAULT_ANALYZING_INTERVAL = 5; // 5 sec
+static int DEFAULT_PLATEAU = 60; // 1 min without new path
+static uint64_t DEFAULT_GAS_BUDGET = 50000000;
+static uint64_t DEFAULT_STEP_LIMIT = 100000;
+static size_t DEFAULT_BATCH_SIZE = 16;
+static size_t DEFAULT_THREADS = 1;
+static size_t DEFAULT_JOBS = 1;
+static int DEFAULT_CHECKPOINT_INTERVAL = 10; // 10 mins
+static int DEFAULT_SYNC_INTERVAL = 30; // 30 sec
 static string DEFAULT_CONTRACTS_FOLDER = "contracts/";
 static string DEFAULT_ASSETS_FOLDER = "assets/";
 static string DEFAULT_ATTACKER = "ReentrancyAttacker";
+static string DEFAULT_OBJECTIVE = "coverage";
+static string DEFAULT_ATTACKER_STRATEGY = "reenter";
 
 int main(int argc, char* argv[]) {
   /* Run EVM silently */
@@ -22,12 +32,31 @@ int main(int argc, char* argv[]) {
   int mode = DEFAULT_MODE;
   int duration = DEFAULT_DURATION;
   int reporter = DEFAULT_REPORTER;
+  int plateau = DEFAULT_PLATEAU;
+  uint64_t gasBudget = DEFAULT_GAS_BUDGET;
+  uint64_t stepLimit = DEFAULT_STEP_LIMIT;
+  size_t batchSize = DEFAULT_BATCH_SIZE;
+  size_t threads = DEFAULT_THREADS;
   string contractsFolder = DEFAULT_CONTRACTS_FOLDER;
   string assetsFolder = DEFAULT_ASSETS_FOLDER;
   string jsonFile = "";
   string contractName = "";
   string sourceFile = "";
   string attackerName = DEFAULT_ATTACKER;
+  string replayFolder = "";
+  string leaderStore = "";
+  string objective = DEFAULT_OBJECTIVE;
+  string attackerStrategy = DEFAULT_ATTACKER_STRATEGY;
+  string forkDb = "";
+  string forkRoot = "";
+  string scanFolder = "";
+  size_t jobs = DEFAULT_JOBS;
+  string checkpoint = "";
+  int checkpointInterval = DEFAULT_CHECKPOINT_INTERVAL;
+  string syncDir = "";
+  string mainId = "";
+  string secondaryId = "";
+  int syncInterval = DEFAULT_SYNC_INTERVAL;
   po::options_description desc("Allowed options");
   po::variables_map vm;
   
@@ -42,7 +71,28 @@ int main(int argc, char* argv[]) {
     ("mode,m", po::value(&mode), "choose mode: 0 - AFL ")
     ("reporter,r", po::value(&reporter), "choose reporter: 0 - TERMINAL | 1 - JSON")
     ("duration,d", po::value(&duration), "fuzz duration")
-    ("attacker", po::value(&attackerName), "choose attacker: NormalAttacker | ReentrancyAttacker");
+    ("plateau", po::value(&plateau), "stop after seconds without new path (0 - never)")
+    ("gas-budget", po::value(&gasBudget), "gas shared by all transactions of a test case")
+    ("step-limit", po::value(&stepLimit), "max VM steps of a transaction (0 - unlimited)")
+    ("batch-size", po::value(&batchSize), "test cases executed together by a mutation stage")
+    ("threads", po::value(&threads), "executors running a batch in parallel")
+    ("objective", po::value(&objective), "choose objective: coverage | gas")
+    ("state-coverage", "also keep test cases reaching new storage states")
+    ("fork-db", po::value(&forkDb), "fork the state of an aleth chain database")
+    ("fork-root", po::value(&forkRoot), "state root of the fork")
+    ("attacker", po::value(&attackerName), "choose attacker: NormalAttacker | ReentrancyAttacker")
+    ("attacker-strategy", po::value(&attackerStrategy), "what the attacker sends when it calls out: reenter | fallback | passthrough")
+    ("replay", po::value(&replayFolder), "execute the witnesses of a findings folder again")
+    ("leader-store", po::value(&leaderStore), "keep leader test cases in a memory mapped file created in this directory")
+    ("checkpoint", po::value(&checkpoint), "write the campaign to a checkpoint file")
+    ("checkpoint-interval", po::value(&checkpointInterval), "minutes between checkpoints (0 - only when fuzzing stops)")
+    ("resume", "continue the campaign of the checkpoint file")
+    ("sync-dir", po::value(&syncDir), "share leaders with peer instances through a directory")
+    ("main", po::value(&mainId), "sync as the main instance with this id")
+    ("secondary", po::value(&secondaryId), "sync as a secondary instance with this id, no deterministic stages")
+    ("sync-interval", po::value(&syncInterval), "seconds between two sync rounds")
+    ("scan", po::value(&scanFolder), "fuzz every .bin-runtime with its .abi in a folder, no source needed")
+    ("jobs", po::value(&jobs), "contracts fuzzed at the same time by --scan");
   po::store(po::parse_command_line(argc, argv, desc), vm);
   po::notify(vm);
   /* Show help message */
@@ -53,23 +103,75 @@ int main(int argc, char* argv[]) {
     fuzzMe << "#!/bin/bash" << endl;
     fuzzMe << compileSolFiles(contractsFolder);
     fuzzMe << compileSolFiles(assetsFolder);
-    fuzzMe << fuzzJsonFiles(contractsFolder, assetsFolder, duration, mode, reporter, attackerName);
+    fuzzMe << fuzzJsonFiles(contractsFolder, assetsFolder, duration, mode, reporter, attackerName, plateau, gasBudget, stepLimit, batchSize, threads, objective, attackerStrategy);
     fuzzMe.close();
     showGenerate();
     return 0;
   }
-  /* Fuzz a single contract */
-  if (vm.count("file") && vm.count("name") && vm.count("source")) {
+  /* A missing or malformed root would silently fork the empty state */
+  if (forkDb.size()) {
+    if (!boost::filesystem::is_directory(forkDb)) {
+      cout << "[x] No chain database " << forkDb << endl;
+      return 1;
+    }
+    if (!isHash<h256>(forkRoot)) {
+      cout << "[x] --fork-root must be the 32 bytes hex state root to fork" << endl;
+      return 1;
+    }
+  }
+  auto fuzzParamOf = [&](vector<ContractInfo> contractInfo) {
     FuzzParam fuzzParam;
-    auto contractInfo = parseAssets(assetsFolder);
-    contractInfo.push_back(parseSource(sourceFile, jsonFile, contractName, true));
     fuzzParam.contractInfo = contractInfo;
     fuzzParam.mode = (FuzzMode) mode;
     fuzzParam.duration = duration;
     fuzzParam.reporter = (Reporter) reporter;
     fuzzParam.analyzingInterval = DEFAULT_ANALYZING_INTERVAL;
+    fuzzParam.plateau = plateau;
+    fuzzParam.gasBudget = gasBudget;
+    fuzzParam.stepLimit = stepLimit;
+    fuzzParam.batchSize = batchSize;
+    fuzzParam.threads = threads;
+    fuzzParam.objective = objective == "gas" ? GAS : COVERAGE;
+    fuzzParam.stateCoverage = vm.count("state-coverage") > 0;
+    fuzzParam.forkDb = forkDb;
+    fuzzParam.forkRoot = forkRoot;
+    fuzzParam.leaderStore = leaderStore;
+    fuzzParam.checkpoint = checkpoint;
+    fuzzParam.checkpointInterval = checkpointInterval;
+    fuzzParam.resume = vm.count("resume") > 0 && checkpoint.size();
+    fuzzParam.syncDir = syncDir;
+    fuzzParam.syncId = secondaryId.size() ? secondaryId : mainId.size() ? mainId : "main";
+    fuzzParam.syncMain = secondaryId.empty();
+    fuzzParam.syncInterval = syncInterval;
     fuzzParam.attackerName = attackerName;
-    Fuzzer fuzzer(fuzzParam);
+    if (attackerStrategy == "fallback") fuzzParam.attackerStrategy = AttackerStrategy::Fallback;
+    if (attackerStrategy == "passthrough") fuzzParam.attackerStrategy = AttackerStrategy::Passthrough;
+    return fuzzParam;
+  };
+  /* Fuzz contracts known only by runtime bytecode and ABI */
+  if (vm.count("scan")) {
+    auto assets = parseAssets(assetsFolder);
+    scanBytecodes(scanFolder, jobs, [&](ContractInfo contractInfo) {
+      auto contracts = assets;
+      contracts.push_back(contractInfo);
+      auto fuzzParam = fuzzParamOf(contracts);
+      if (checkpoint.size()) fuzzParam.checkpoint = checkpoint + "." + contractInfo.contractName;
+      if (syncDir.size()) fuzzParam.syncDir = syncDir + "/" + contractInfo.contractName;
+      cout << ">> Scan " << contractInfo.contractName << endl;
+      Fuzzer fuzzer(fuzzParam);
+      fuzzer.start();
+    });
+    return 0;
+  }
+  /* Fuzz a single contract */
+  if (vm.count("file") && vm.count("name") && vm.count("source")) {
+    auto contractInfo = parseAssets(assetsFolder);
+    contractInfo.push_back(parseSource(sourceFile, jsonFile, contractName, true));
+    Fuzzer fuzzer(fuzzParamOf(contractInfo));
+    if (vm.count("replay")) {
+      cout << ">> Replay " << contractName << endl;
+      return fuzzer.replay(replayFolder) ? 1 : 0;
+    }
     cout << ">> Fuzz " << contractName << endl;
     fuzzer.start();
     return 0;
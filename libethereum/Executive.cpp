@@ -346,6 +346,8 @@ bool Executive::call(CallParameters const& _p, u256 const& _gasPrice, Address co
             m_ext = make_shared<ExtVM>(m_s, m_envInfo, m_sealEngine, _p.receiveAddress,
                 _p.senderAddress, _origin, _p.apparentValue, _gasPrice, _p.data, &c, codeHash,
                 m_depth, false, _p.staticCall);
+            m_ext->stepBudget = m_stepBudget;
+            m_ext->attacker = m_attacker;
         }
     }
 
@@ -411,8 +413,12 @@ bool Executive::executeCreate(Address const& _sender, u256 const& _endowment, u2
 
     // Schedule _init execution if not empty.
     if (!_init.empty())
+    {
         m_ext = make_shared<ExtVM>(m_s, m_envInfo, m_sealEngine, m_newAddress, _sender, _origin,
             _endowment, _gasPrice, bytesConstRef(), _init, sha3(_init), m_depth, true, false);
+        m_ext->stepBudget = m_stepBudget;
+        m_ext->attacker = m_attacker;
+    }
 
     return !m_ext;
 }
@@ -424,6 +430,20 @@ void Executive::updateBlock(int64_t _blockNumber, int64_t _timestamp) {
     }
 }
 
+void Executive::setStepBudget(StepBudget* _budget)
+{
+    m_stepBudget = _budget;
+    if (m_ext)
+        m_ext->stepBudget = _budget;
+}
+
+void Executive::setAttacker(AttackerContext const* _attacker)
+{
+    m_attacker = _attacker;
+    if (m_ext)
+        m_ext->attacker = _attacker;
+}
+
 OnOpFunc Executive::simpleTrace()
 {
     Logger& traceLogger = m_vmTraceLogger;
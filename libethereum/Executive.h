@@ -188,6 +188,12 @@ public:
     
     void updateBlock(int64_t _blockNumber, int64_t _timestamp);
 
+    /// Share a step budget with the VM and every nested call/create of this execution.
+    void setStepBudget(StepBudget* _budget);
+
+    /// Share the attacker contracts with the VM and every nested call/create of this execution.
+    void setAttacker(AttackerContext const* _attacker);
+
 private:
     /// @returns false iff go() must be called (and thus a VM execution in required).
     bool executeCreate(Address const& _txSender, u256 const& _endowment, u256 const& _gasPrice, u256 const& _gas, bytesConstRef _code, Address const& _originAddress);
@@ -198,6 +204,8 @@ private:
     std::shared_ptr<ExtVM> m_ext;		///< The VM externality object for the VM execution or null if no VM is required. shared_ptr used only to allow ExtVM forward reference. This field does *NOT* survive this object.
     owning_bytes_ref m_output;			///< Execution output.
     ExecutionResult* m_res = nullptr;	///< Optional storage for execution results.
+    StepBudget* m_stepBudget = nullptr;	///< Optional step budget shared with nested executions.
+    AttackerContext const* m_attacker = nullptr;	///< Optional attackers shared with nested executions.
 
     unsigned m_depth = 0;				///< The context's call-depth.
     TransactionException m_excepted = TransactionException::None;	///< Details if the VM's execution resulted in an exception.
@@ -23,6 +23,12 @@
 #include "LastBlockHashesFace.h"
 #include <boost/thread.hpp>
 #include <exception>
+#include <functional>
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+#endif
 
 using namespace dev;
 using namespace dev::eth;
@@ -51,25 +57,97 @@ static size_t const c_entryOverhead = 128 * 1024;
 /// On what depth execution should be offloaded to additional separated stack space.
 static unsigned const c_offloadPoint = (c_defaultStackSize - c_entryOverhead) / c_singleExecutionStackSize;
 
-void goOnOffloadedStack(Executive& _e, OnOpFunc const& _onOp)
+/// Stack size enough to handle the rest of the calls up to the limit.
+static size_t const c_offloadedStackSize = (c_depthLimit - c_offloadPoint) * c_singleExecutionStackSize;
+
+/// Runs _f in a new thread with a big stack and joins it immediately.
+void runOnBigStackThread(std::function<void()> const& _f)
 {
-    // Set new stack size enouth to handle the rest of the calls up to the limit.
     boost::thread::attributes attrs;
-    attrs.set_stack_size((c_depthLimit - c_offloadPoint) * c_singleExecutionStackSize);
+    attrs.set_stack_size(c_offloadedStackSize);
+    boost::thread{attrs, _f}.join();
+}
+
+#if !defined(_WIN32)
+/// Additional stack space of a thread, mapped on first use and reused by every execution
+/// reaching the offloading point. Switching to it costs no thread creation.
+class OffloadedStack
+{
+public:
+    OffloadedStack()
+    {
+        m_guardSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        void* memory = mmap(nullptr, m_guardSize + c_offloadedStackSize, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (memory == MAP_FAILED)
+            return;
+        // Overflow hits the guard page instead of the memory below the stack.
+        mprotect(memory, m_guardSize, PROT_NONE);
+        m_memory = static_cast<char*>(memory);
+    }
+
+    /// Pages stay faulted in between runs, that is what makes a reused stack cheap. They are
+    /// given back when the thread exits, until then a thread holds at most its deepest run.
+    ~OffloadedStack()
+    {
+        if (m_memory)
+            munmap(m_memory, m_guardSize + c_offloadedStackSize);
+    }
+
+    static OffloadedStack& local()
+    {
+        thread_local OffloadedStack stack;
+        return stack;
+    }
+
+    /// Runs _f on this stack and returns when it is done. False if the stack is not available,
+    /// _f must not let exceptions out.
+    bool run(std::function<void()> const& _f)
+    {
+        if (!m_memory || m_task)
+            return false;
+        m_task = &_f;
+        getcontext(&m_callee);
+        m_callee.uc_stack.ss_sp = m_memory + m_guardSize;
+        m_callee.uc_stack.ss_size = c_offloadedStackSize;
+        m_callee.uc_link = &m_caller;
+        makecontext(&m_callee, &OffloadedStack::entry, 0);
+        swapcontext(&m_caller, &m_callee);
+        m_task = nullptr;
+        return true;
+    }
+
+private:
+    /// Returning resumes m_caller through uc_link.
+    static void entry() { (*local().m_task)(); }
 
-    // Create new thread with big stack and join immediately.
-    // TODO: It is possible to switch the implementation to Boost.Context or similar when the API is stable.
+    char* m_memory = nullptr;
+    size_t m_guardSize = 0;
+    std::function<void()> const* m_task = nullptr;
+    ucontext_t m_caller;
+    ucontext_t m_callee;
+};
+#endif
+
+void goOnOffloadedStack(Executive& _e, OnOpFunc const& _onOp)
+{
     boost::exception_ptr exception;
-    boost::thread{attrs, [&]{
+    std::function<void()> task = [&]{
         try
         {
             _e.go(_onOp);
         }
         catch (...)
         {
-            exception = boost::current_exception(); // Catch all exceptions to be rethrown in parent thread.
+            exception = boost::current_exception(); // Catch all exceptions to be rethrown on the caller stack.
         }
-    }}.join();
+    };
+#if defined(_WIN32)
+    runOnBigStackThread(task);
+#else
+    if (!OffloadedStack::local().run(task))
+        runOnBigStackThread(task);
+#endif
     if (exception)
         boost::rethrow_exception(exception);
 }
@@ -126,6 +204,8 @@ evmc_status_code transactionExceptionToEvmcStatusCode(TransactionException ex) n
 CallResult ExtVM::call(CallParameters& _p)
 {
     Executive e{m_s, envInfo(), m_sealEngine, depth + 1};
+    e.setStepBudget(stepBudget);
+    e.setAttacker(attacker);
     if (!e.call(_p, gasPrice, origin))
     {
         go(depth, e, _p.onOp);
@@ -154,6 +234,8 @@ void ExtVM::setStore(u256 _n, u256 _v)
 CreateResult ExtVM::create(u256 _endowment, u256& io_gas, bytesConstRef _code, Instruction _op, u256 _salt, OnOpFunc const& _onOp)
 {
     Executive e{m_s, envInfo(), m_sealEngine, depth + 1};
+    e.setStepBudget(stepBudget);
+    e.setAttacker(attacker);
     bool result = false;
     if (_op == Instruction::CREATE)
         result = e.createOpcode(myAddress, _endowment, gasPrice, io_gas, _code, origin);
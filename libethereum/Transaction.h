@@ -51,7 +51,8 @@ enum class TransactionException
 	StackUnderflow,
 	RevertInstruction,
 	InvalidZeroSignatureFormat,
-	AddressAlreadyUsed
+	AddressAlreadyUsed,
+	StepLimitReached		///< Exhausted the step budget of the execution.
 };
 
 enum class CodeDeposit
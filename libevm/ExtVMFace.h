@@ -33,6 +33,7 @@
 #include <boost/optional.hpp>
 #include <functional>
 #include <set>
+#include <unordered_map>
 
 namespace dev
 {
@@ -108,6 +109,34 @@ struct SubState
     }
 };
 
+/// Number of VM steps an execution may take, shared by all of its nested frames.
+struct StepBudget
+{
+    uint64_t limit = 0;  ///< 0 means unlimited.
+    uint64_t steps = 0;
+};
+
+/// What an attacker contract sends when it calls another contract.
+enum class AttackerStrategy
+{
+    Passthrough,  ///< Its own calldata, it behaves like any other contract.
+    Reenter,      ///< Calldata of the transaction, it calls the same function again.
+    Fallback      ///< No calldata, it calls the fallback function.
+};
+
+/// Attacker contracts of an execution, shared by all of its nested frames.
+struct AttackerContext
+{
+    std::unordered_map<Address, AttackerStrategy> strategies;
+    bytesConstRef payload;  ///< Calldata of the transaction, owned by the caller of the execution.
+
+    AttackerStrategy strategy(Address const& _address) const
+    {
+        auto it = strategies.find(_address);
+        return it == strategies.end() ? AttackerStrategy::Passthrough : it->second;
+    }
+};
+
 class ExtVMFace;
 class LastBlockHashesFace;
 class VMFace;
@@ -276,6 +305,8 @@ public:
     unsigned depth = 0;       ///< Depth of the present call.
     bool isCreate = false;    ///< Is this a CREATE call?
     bool staticCall = false;  ///< Throw on state changing.
+    StepBudget* stepBudget = nullptr;  ///< Step budget shared with the other frames, if any.
+    AttackerContext const* attacker = nullptr;  ///< Attackers of the execution, if any.
     int64_t timestamp = 0;
     int64_t number = 0;
 };
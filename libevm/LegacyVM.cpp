@@ -36,8 +36,6 @@ template <class S> S modWorkaround(S const& _a, S const& _b)
     return (S)(s512(_a) % s512(_b));
 }
 
-bytes LegacyVM::payload = bytes(0, 0);
-
 //
 // for decoding destinations of JUMPTO, JUMPV, JUMPSUB and JUMPSUBV
 //
@@ -75,11 +73,23 @@ uint64_t LegacyVM::decodeJumpvDest(const byte* const _code, uint64_t& _pc, byte
 void LegacyVM::onOperation()
 {
     if (m_onOp)
-        (m_onOp)(++m_nSteps, m_PC, m_OP,
+        (m_onOp)(m_nSteps, m_PC, m_OP,
             m_newMemSize > m_mem.size() ? (m_newMemSize - m_mem.size()) / 32 : uint64_t(0),
             m_runGas, m_io_gas, this, m_ext);
 }
 
+//
+// charge the steps taken since the last charge to the budget shared by all frames,
+// done on jumps only since loops cannot be built without them
+//
+void LegacyVM::chargeSteps()
+{
+    m_stepBudget->steps += m_nSteps - m_chargedSteps;
+    m_chargedSteps = m_nSteps;
+    if (m_stepBudget->limit && m_stepBudget->steps > m_stepBudget->limit)
+        throwStepLimitReached();
+}
+
 //
 // set current SP to SP', adjust SP' per _removed and _added items
 //
@@ -200,6 +210,7 @@ void LegacyVM::logGasMem()
 
 void LegacyVM::fetchInstruction()
 {
+    ++m_nSteps;
     m_OP = Instruction(m_code[m_PC]);
     const InstructionMetric& metric = c_metrics[static_cast<size_t>(m_OP)];
     adjustStack(metric.args, metric.ret);
@@ -215,6 +226,30 @@ void LegacyVM::fetchInstruction()
 //
 // interpreter entry point
 
+void LegacyVM::reset() noexcept
+{
+    // Memory buffers grown by a single huge execution are not worth keeping.
+    if (m_mem.capacity() > c_maxPooledMemory)
+        bytes().swap(m_mem);
+    m_mem.clear();
+    m_code.clear();
+    m_returnData.clear();
+    m_pool.clear();
+    m_jumpDests.clear();
+    m_beginSubs.clear();
+    m_output = owning_bytes_ref{};
+    m_onOp = OnOpFunc{};
+    m_ext = nullptr;
+    m_SP = m_SPP = m_stackEnd;
+#if EIP_615
+    m_RP = m_return - 1;
+    m_frameSize.clear();
+#endif
+    m_runGas = 0;
+    m_newMemSize = 0;
+    m_copyMemSize = 0;
+}
+
 owning_bytes_ref LegacyVM::exec(u256& _io_gas, ExtVMFace& _ext, OnOpFunc const& _onOp)
 {
     m_io_gas_p = &_io_gas;
@@ -223,6 +258,9 @@ owning_bytes_ref LegacyVM::exec(u256& _io_gas, ExtVMFace& _ext, OnOpFunc const&
     m_schedule = &m_ext->evmSchedule();
     m_onOp = _onOp;
     m_onFail = &LegacyVM::onOperation; // this results in operations that fail being logged twice in the trace
+    m_stepBudget = _ext.stepBudget;
+    m_nSteps = 0;
+    m_chargedSteps = 0;
     m_PC = 0;
 
     try
@@ -240,6 +278,8 @@ owning_bytes_ref LegacyVM::exec(u256& _io_gas, ExtVMFace& _ext, OnOpFunc const&
         throw;
     }
 
+    if (m_stepBudget)
+        m_stepBudget->steps += m_nSteps - m_chargedSteps;
     *m_io_gas_p = m_io_gas;
     return std::move(m_output);
 }
@@ -1531,6 +1571,8 @@ void LegacyVM::interpretCases()
         {
             ON_OP();
             updateIOGas();
+            if (m_stepBudget)
+                chargeSteps();
             m_PC = verifyJumpDest(m_SP[0]);
         }
         CONTINUE
@@ -1539,6 +1581,8 @@ void LegacyVM::interpretCases()
         {
             ON_OP();
             updateIOGas();
+            if (m_stepBudget)
+                chargeSteps();
             if (m_SP[1])
                 m_PC = verifyJumpDest(m_SP[0]);
             else
@@ -1551,6 +1595,8 @@ void LegacyVM::interpretCases()
 #if EVM_REPLACE_CONST_JUMP
             ON_OP();
             updateIOGas();
+            if (m_stepBudget)
+                chargeSteps();
 
             m_PC = uint64_t(m_SP[0]);
 #else
@@ -1564,6 +1610,8 @@ void LegacyVM::interpretCases()
 #if EVM_REPLACE_CONST_JUMP
             ON_OP();
             updateIOGas();
+            if (m_stepBudget)
+                chargeSteps();
 
             if (m_SP[1])
                 m_PC = uint64_t(m_SP[0]);
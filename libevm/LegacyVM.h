@@ -43,9 +43,17 @@ public:
         reverse(stack.begin(), stack.end());
         return stack;
     };
-    static bytes payload;
+    /// Item _n below the top of the stack, without copying the stack.
+    u256 const& stackItem(size_t _n) const { return m_SP[_n]; }
+    size_t stackDepth() const { return m_stackEnd - m_SP; }
+
+    /// Forget the last execution so the instance can run another one. Memory, code and
+    /// return data buffers keep their capacity.
+    void reset() noexcept;
 
 private:
+    /// Largest memory buffer reset() keeps.
+    static size_t const c_maxPooledMemory = 1024 * 1024;
 
     u256* m_io_gas_p = 0;
     uint64_t m_io_gas = 0;
@@ -60,6 +68,8 @@ private:
     MemFnPtr m_bounce = 0;
     MemFnPtr m_onFail = 0;
     uint64_t m_nSteps = 0;
+    StepBudget* m_stepBudget = nullptr;
+    uint64_t m_chargedSteps = 0;
     EVMSchedule const* m_schedule = nullptr;
 
     // return bytes
@@ -126,12 +136,14 @@ private:
     void throwRevertInstruction(owning_bytes_ref&& _output);
     void throwDisallowedStateChange();
     void throwBufferOverrun(bigint const& _enfOfAccess);
+    void throwStepLimitReached();
 
     std::vector<uint64_t> m_beginSubs;
     std::vector<uint64_t> m_jumpDests;
     int64_t verifyJumpDest(u256 const& _dest, bool _throw = true);
 
     void onOperation();
+    void chargeSteps();
     void adjustStack(unsigned _removed, unsigned _added);
     uint64_t gasForMem(u512 _size);
     void updateSSGas();
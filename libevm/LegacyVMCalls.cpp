@@ -55,6 +55,11 @@ void LegacyVM::throwBadJumpDestination()
     BOOST_THROW_EXCEPTION(BadJumpDestination());
 }
 
+void LegacyVM::throwStepLimitReached()
+{
+    BOOST_THROW_EXCEPTION(StepLimitReached());
+}
+
 void LegacyVM::throwDisallowedStateChange()
 {
     BOOST_THROW_EXCEPTION(DisallowedStateChange());
@@ -273,11 +278,18 @@ bool LegacyVM::caseCallSetup(CallParameters *callParams, bytesRef& o_output)
         callParams->onOp = m_onOp;
         callParams->senderAddress = m_OP == Instruction::DELEGATECALL ? m_ext->caller : m_ext->myAddress;
         callParams->receiveAddress = (m_OP == Instruction::CALL || m_OP == Instruction::STATICCALL) ? callParams->codeAddress : m_ext->myAddress;
-        if (m_ext->myAddress == Address(0xf0)) {
-            auto size = LegacyVM::payload.size();
-            callParams->data = bytesConstRef(LegacyVM::payload.data(), size);
-        } else {
+        auto strategy = m_ext->attacker ? m_ext->attacker->strategy(m_ext->myAddress) : AttackerStrategy::Passthrough;
+        switch (strategy)
+        {
+        case AttackerStrategy::Reenter:
+            callParams->data = m_ext->attacker->payload;
+            break;
+        case AttackerStrategy::Fallback:
+            callParams->data = bytesConstRef();
+            break;
+        default:
             callParams->data = bytesConstRef(m_mem.data() + inOff, inSize);
+            break;
         }
         o_output = bytesRef(m_mem.data() + outOff, outSize);
         return true;
@@ -83,7 +83,7 @@ namespace dev
         #undef ON_OP
 #if EVM_TRACE > 2
 #define ON_OP() \
-    (cerr << "### " << ++m_nSteps << ": " << m_PC << " " << instructionInfo(m_OP).name << endl)
+    (cerr << "### " << m_nSteps << ": " << m_PC << " " << instructionInfo(m_OP).name << endl)
 #else
 #define ON_OP() onOperation()
 #endif
@@ -174,6 +174,50 @@ po::options_description vmProgramOptions(unsigned _lineLength)
 }
 
 
+namespace
+{
+/// Legacy VMs of a thread which are not executing. Calls nest, so a thread needs at most
+/// as many instances as the deepest call it made.
+/// Kept instances are capped, the frames of a rare deep call chain are freed again.
+constexpr size_t c_maxPooledVMs = 16;
+
+std::vector<std::unique_ptr<LegacyVM>>& legacyVMPool()
+{
+    thread_local std::vector<std::unique_ptr<LegacyVM>> pool;
+    return pool;
+}
+
+LegacyVM* acquireLegacyVM()
+{
+    auto& pool = legacyVMPool();
+    if (pool.empty())
+        return new LegacyVM;
+    auto vm = pool.back().release();
+    pool.pop_back();
+    return vm;
+}
+
+void releaseLegacyVM(VMFace* _vm) noexcept
+{
+    auto vm = static_cast<LegacyVM*>(_vm);
+    auto& pool = legacyVMPool();
+    if (pool.size() >= c_maxPooledVMs)
+    {
+        delete vm;
+        return;
+    }
+    vm->reset();
+    try
+    {
+        pool.emplace_back(vm);
+    }
+    catch (...)
+    {
+        delete vm;
+    }
+}
+}  // namespace
+
 VMPtr VMFactory::create()
 {
     return create(g_kind);
@@ -194,7 +238,8 @@ VMPtr VMFactory::create(VMKind _kind)
         return {g_evmcDll.get(), null_delete};
     case VMKind::Legacy:
     default:
-        return {new LegacyVM, default_delete};
+        // Returned to the pool of the thread when the frame is done with it.
+        return {acquireLegacyVM(), releaseLegacyVM};
     }
 }
 }  // namespace eth
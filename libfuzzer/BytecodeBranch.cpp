@@ -5,6 +5,20 @@
 namespace fuzzer {
 
   BytecodeBranch::BytecodeBranch(const ContractInfo &contractInfo) {
+    /* Without source maps the branches are the JUMPIs reachable from function entries */
+    if (contractInfo.srcmapRuntime.empty()) {
+      auto binRuntime = fromHex(contractInfo.binRuntime);
+      for (auto it : findFunctionReach(binRuntime)) {
+        runtimeJumpis.insert(it.second.jumpis.begin(), it.second.jumpis.end());
+      }
+      /* No dispatcher found, take them all */
+      if (runtimeJumpis.empty()) {
+        for (auto it : decodeBytecode(binRuntime)) {
+          if (it.second == Instruction::JUMPI) runtimeJumpis.insert(it.first);
+        }
+      }
+      return;
+    }
     auto deploymentBin = contractInfo.bin.substr(0, contractInfo.bin.size() - contractInfo.binRuntime.size());
     auto progInfo = {
         make_tuple(fromHex(deploymentBin), contractInfo.srcmap, false),
@@ -96,6 +110,94 @@ namespace fuzzer {
     return instructions;
   }
 
+  /*
+   * Walk every function from its dispatcher entry: DUP1 PUSH4 selector EQ PUSH dest JUMPI.
+   * A jump to a pushed constant has one target, other jumps are returns of internal calls
+   * and may go to any JUMPDEST pushed by the code already reached
+   */
+  unordered_map<uint32_t, FunctionReach> BytecodeBranch::findFunctionReach(bytes bytecode) {
+    struct Op {
+      uint64_t pc;
+      Instruction inst;
+      u256 value;
+    };
+    vector<Op> ops;
+    unordered_map<uint64_t, uint64_t> jumpdests;
+    uint64_t pc = 0;
+    while (pc < bytecode.size()) {
+      Op op = { pc, (Instruction) bytecode[pc], 0 };
+      if (op.inst >= Instruction::PUSH1 && op.inst <= Instruction::PUSH32) {
+        auto pushNum = bytecode[pc] - (uint64_t) Instruction::PUSH1 + 1;
+        for (uint64_t i = 1; i <= pushNum; i ++) {
+          op.value = (op.value << 8) | (pc + i < bytecode.size() ? bytecode[pc + i] : 0);
+        }
+        pc += pushNum;
+      }
+      if (op.inst == Instruction::JUMPDEST) jumpdests[op.pc] = ops.size();
+      ops.push_back(op);
+      pc ++;
+    }
+    auto isPush = [&](uint64_t i) {
+      return ops[i].inst >= Instruction::PUSH1 && ops[i].inst <= Instruction::PUSH32;
+    };
+    auto jumpdestOf = [&](const u256 &value) {
+      return value < bytecode.size() ? jumpdests.find((uint64_t) value) : jumpdests.end();
+    };
+    unordered_map<uint32_t, FunctionReach> reaches;
+    for (uint64_t i = 0; i + 3 < ops.size(); i ++) {
+      if (ops[i].inst != Instruction::PUSH4) continue;
+      /* Newer compilers compare with PUSH4 selector DUP2 EQ */
+      auto eq = ops[i + 1].inst == Instruction::DUP2 ? i + 2 : i + 1;
+      if (eq + 2 >= ops.size() || ops[eq].inst != Instruction::EQ) continue;
+      if (!isPush(eq + 1) || ops[eq + 2].inst != Instruction::JUMPI) continue;
+      auto entry = jumpdestOf(ops[eq + 1].value);
+      auto selector = (uint32_t) ops[i].value;
+      if (entry == jumpdests.end() || reaches.count(selector)) continue;
+      FunctionReach reach;
+      reach.known = true;
+      vector<bool> visited(ops.size(), false);
+      vector<uint64_t> pushedDests;
+      vector<uint64_t> worklist = { entry->second };
+      bool hasReturn = false;
+      while (worklist.size()) {
+        auto idx = worklist.back();
+        worklist.pop_back();
+        while (idx < ops.size() && !visited[idx]) {
+          visited[idx] = true;
+          auto inst = ops[idx].inst;
+          if (isPush(idx)) {
+            auto dest = jumpdestOf(ops[idx].value);
+            if (dest != jumpdests.end()) {
+              pushedDests.push_back(dest->second);
+              if (hasReturn) worklist.push_back(dest->second);
+            }
+          }
+          if (inst == Instruction::SSTORE) reach.writesState = true;
+          if (inst == Instruction::JUMPI) reach.jumpis.insert(ops[idx].pc);
+          if (inst == Instruction::JUMP || inst == Instruction::JUMPI) {
+            auto dest = idx && isPush(idx - 1) ? jumpdestOf(ops[idx - 1].value) : jumpdests.end();
+            if (dest != jumpdests.end()) {
+              worklist.push_back(dest->second);
+            } else if (!hasReturn) {
+              hasReturn = true;
+              worklist.insert(worklist.end(), pushedDests.begin(), pushedDests.end());
+            }
+          }
+          if (inst == Instruction::JUMP
+            || inst == Instruction::STOP
+            || inst == Instruction::RETURN
+            || inst == Instruction::REVERT
+            || inst == Instruction::INVALID
+            || inst == Instruction::SUICIDE
+          ) break;
+          idx ++;
+        }
+      }
+      reaches[selector] = reach;
+    }
+    return reaches;
+  }
+
   pair<unordered_set<uint64_t>, unordered_set<uint64_t>> BytecodeBranch::findValidJumpis() {
     return make_pair(deploymentJumpis, runtimeJumpis);
   }
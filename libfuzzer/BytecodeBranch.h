@@ -16,6 +16,7 @@ namespace fuzzer {
       pair<unordered_set<uint64_t>, unordered_set<uint64_t>> findValidJumpis();
       static vector<vector<uint64_t>> decompressSourcemap(string srcmap);
       static vector<pair<uint64_t, Instruction>> decodeBytecode(bytes bytecode);
+      static unordered_map<uint32_t, FunctionReach> findFunctionReach(bytes bytecode);
   };
 
 }
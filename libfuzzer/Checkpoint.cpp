@@ -0,0 +1,101 @@
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+#include "Checkpoint.h"
+
+namespace fuzzer {
+  void CheckpointWriter::u64(uint64_t value) {
+    for (int i = 0; i < 8; i ++) buffer.push_back((byte) (value >> (8 * i)));
+  }
+
+  void CheckpointWriter::real(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    u64(bits);
+  }
+
+  void CheckpointWriter::word(const u256 &value) {
+    auto bigEndian = h256(value).asBytes();
+    buffer.insert(buffer.end(), bigEndian.begin(), bigEndian.end());
+  }
+
+  void CheckpointWriter::data(const bytes &value) {
+    u64(value.size());
+    buffer.insert(buffer.end(), value.begin(), value.end());
+  }
+
+  bool CheckpointReader::has(uint64_t size) {
+    if (!failed && size <= buffer.size() - pos) return true;
+    failed = true;
+    return false;
+  }
+
+  uint64_t CheckpointReader::u64() {
+    if (!has(8)) return 0;
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i ++) value |= (uint64_t) buffer[pos + i] << (8 * i);
+    pos += 8;
+    return value;
+  }
+
+  uint64_t CheckpointReader::count() {
+    auto value = u64();
+    if (value <= remaining() / 8) return value;
+    failed = true;
+    return 0;
+  }
+
+  double CheckpointReader::real() {
+    auto bits = u64();
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  u256 CheckpointReader::word() {
+    if (!has(32)) return 0;
+    auto value = fromBigEndian<u256>(bytesConstRef(buffer.data() + pos, 32));
+    pos += 32;
+    return value;
+  }
+
+  bytes CheckpointReader::data() {
+    auto size = u64();
+    if (!has(size)) return bytes();
+    bytes value(buffer.begin() + pos, buffer.begin() + pos + size);
+    pos += size;
+    return value;
+  }
+
+  vector<string> CheckpointReader::strings() {
+    vector<string> values;
+    auto numValues = count();
+    for (uint64_t i = 0; i < numValues && good(); i ++) values.push_back(str());
+    return values;
+  }
+
+  bool writeCheckpoint(string file, const bytes &data) {
+    auto tmpFile = file + ".tmp";
+    auto fd = open(tmpFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    size_t written = 0;
+    while (written < data.size()) {
+      auto ret = write(fd, data.data() + written, data.size() - written);
+      if (ret <= 0) break;
+      written += ret;
+    }
+    auto ok = written == data.size() && !fsync(fd);
+    close(fd);
+    if (ok) ok = !rename(tmpFile.c_str(), file.c_str());
+    if (!ok) unlink(tmpFile.c_str());
+    return ok;
+  }
+
+  bool readCheckpoint(string file, bytes &data) {
+    ifstream in(file, ios::binary);
+    if (!in.is_open()) return false;
+    data.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    return true;
+  }
+}
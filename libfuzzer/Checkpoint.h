@@ -0,0 +1,46 @@
+#pragma once
+#include <vector>
+#include "Common.h"
+
+using namespace dev;
+using namespace std;
+
+namespace fuzzer {
+  /* Fields of a checkpoint in the order they are written, integers are little endian */
+  class CheckpointWriter {
+      bytes buffer;
+    public:
+      void u64(uint64_t value);
+      void real(double value);
+      void word(const u256 &value);
+      void data(const bytes &value);
+      void str(const string &value) { data(bytes(value.begin(), value.end())); }
+      template<typename T> void strings(const T &values) {
+        u64(values.size());
+        for (auto &value : values) str(value);
+      }
+      const bytes &out() const { return buffer; }
+  };
+  /* Reads the fields back, a truncated checkpoint reads zeros and fails */
+  class CheckpointReader {
+      const bytes &buffer;
+      size_t pos = 0;
+      bool failed = false;
+      bool has(uint64_t size);
+    public:
+      CheckpointReader(const bytes &_buffer): buffer(_buffer) {}
+      uint64_t u64();
+      /* Number of elements which follow, each takes at least 8 bytes */
+      uint64_t count();
+      double real();
+      u256 word();
+      bytes data();
+      string str() { auto value = data(); return string(value.begin(), value.end()); }
+      vector<string> strings();
+      size_t remaining() const { return failed ? 0 : buffer.size() - pos; }
+      bool good() const { return !failed; }
+  };
+  /* Written aside, synced and renamed, a crash keeps the previous checkpoint */
+  bool writeCheckpoint(string file, const bytes &data);
+  bool readCheckpoint(string file, bytes &data);
+}
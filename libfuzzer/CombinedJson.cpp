@@ -0,0 +1,271 @@
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <unistd.h>
+#include "CombinedJson.h"
+
+namespace fuzzer {
+  void CombinedJson::whitespace() {
+    while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) p ++;
+  }
+
+  bool CombinedJson::consume(char c) {
+    whitespace();
+    if (p >= end || *p != c) return false;
+    p ++;
+    return true;
+  }
+
+  static void appendUtf8(string &out, uint32_t c) {
+    if (c < 0x80) {
+      out += (char) c;
+    } else if (c < 0x800) {
+      out += (char) (0xc0 | (c >> 6));
+      out += (char) (0x80 | (c & 0x3f));
+    } else if (c < 0x10000) {
+      out += (char) (0xe0 | (c >> 12));
+      out += (char) (0x80 | ((c >> 6) & 0x3f));
+      out += (char) (0x80 | (c & 0x3f));
+    } else {
+      out += (char) (0xf0 | (c >> 18));
+      out += (char) (0x80 | ((c >> 12) & 0x3f));
+      out += (char) (0x80 | ((c >> 6) & 0x3f));
+      out += (char) (0x80 | (c & 0x3f));
+    }
+  }
+
+  /* The 4 hex digits of a \\u escape */
+  bool CombinedJson::readHex4(const char *from, uint32_t &out) {
+    if (end - from < 4) return false;
+    out = 0;
+    for (auto q = from; q < from + 4; q ++) {
+      if (!isxdigit((unsigned char) *q)) return false;
+      out = out << 4 | (uint32_t) (isdigit((unsigned char) *q) ? *q - '0' : tolower((unsigned char) *q) - 'a' + 10);
+    }
+    return true;
+  }
+
+  /* Skipped strings (out is null) are only scanned for their closing quote */
+  bool CombinedJson::readString(string *out) {
+    if (!consume('"')) return false;
+    if (out) out->clear();
+    while (p < end && *p != '"') {
+      if (*p != '\\') {
+        auto start = p;
+        while (p < end && *p != '"' && *p != '\\') p ++;
+        if (out) out->append(start, p);
+        continue;
+      }
+      if (++ p >= end) return false;
+      auto escaped = *p ++;
+      if (!out) {
+        if (escaped == 'u') p += min<ptrdiff_t>(4, end - p);
+        continue;
+      }
+      switch (escaped) {
+        case 'b': *out += '\b'; break;
+        case 'f': *out += '\f'; break;
+        case 'n': *out += '\n'; break;
+        case 'r': *out += '\r'; break;
+        case 't': *out += '\t'; break;
+        case 'u': {
+          uint32_t c = 0;
+          if (!readHex4(p, c)) return false;
+          p += 4;
+          /* Surrogate pair */
+          uint32_t low = 0;
+          if (c >= 0xd800 && c < 0xdc00 && end - p >= 6 && p[0] == '\\' && p[1] == 'u' && readHex4(p + 2, low) && low >= 0xdc00 && low < 0xe000) {
+            c = 0x10000 + ((c - 0xd800) << 10) + (low - 0xdc00);
+            p += 6;
+          }
+          appendUtf8(*out, c);
+          break;
+        }
+        default: *out += escaped;
+      }
+    }
+    if (p >= end) return false;
+    p ++;
+    return true;
+  }
+
+  bool CombinedJson::readBool(bool &out) {
+    whitespace();
+    if (end - p >= 4 && !strncmp(p, "true", 4)) {
+      out = true;
+      p += 4;
+      return true;
+    }
+    if (end - p >= 5 && !strncmp(p, "false", 5)) {
+      out = false;
+      p += 5;
+      return true;
+    }
+    return skipValue();
+  }
+
+  bool CombinedJson::skipValue() {
+    whitespace();
+    if (p >= end) return false;
+    if (*p == '"') return readString(nullptr);
+    if (*p == '{') return readObject([&](const string &) { return skipValue(); });
+    if (*p == '[') return readArray([&] { return skipValue(); });
+    /* Number, true, false or null */
+    auto start = p;
+    while (p < end && *p != ',' && *p != '}' && *p != ']' && *p != ' ' && *p != '\n' && *p != '\r' && *p != '\t') p ++;
+    return p != start;
+  }
+
+  bool CombinedJson::readObject(function<bool (const string &)> onKey) {
+    if (!consume('{')) return false;
+    if (consume('}')) return true;
+    string key;
+    do {
+      if (!readString(&key) || !consume(':') || !onKey(key)) return false;
+    } while (consume(','));
+    return consume('}');
+  }
+
+  bool CombinedJson::readArray(function<bool ()> onItem) {
+    if (!consume('[')) return false;
+    if (consume(']')) return true;
+    do {
+      if (!onItem()) return false;
+    } while (consume(','));
+    return consume(']');
+  }
+
+  bool CombinedJson::readContract(ContractInfo &info) {
+    return readObject([&](const string &key) {
+      if (key == "abi") {
+        /* Older solc embeds the abi as a string, newer solc as an array */
+        whitespace();
+        if (p < end && *p == '"') return readString(&info.abiJson);
+        auto start = p;
+        if (!skipValue()) return false;
+        info.abiJson = string(start, p);
+        return true;
+      }
+      if (key == "bin") return readString(&info.bin);
+      if (key == "bin-runtime") return readString(&info.binRuntime);
+      if (key == "srcmap") return readString(&info.srcmap);
+      if (key == "srcmap-runtime") return readString(&info.srcmapRuntime);
+      return skipValue();
+    });
+  }
+
+  /* A legacy AST node, keys come in any order so the verdict waits for the closing brace */
+  bool CombinedJson::readNode(vector<string> &constantFunctionSrcmap) {
+    string name;
+    string src;
+    bool constant = false;
+    auto ok = readObject([&](const string &key) {
+      if (key == "name") return readString(&name);
+      if (key == "src") return readString(&src);
+      if (key == "children") return readArray([&] { return readNode(constantFunctionSrcmap); });
+      if (key == "attributes") return readObject([&](const string &attribute) {
+        return attribute == "constant" ? readBool(constant) : skipValue();
+      });
+      return skipValue();
+    });
+    if (ok && constant && name == "FunctionDefinition") constantFunctionSrcmap.push_back(src);
+    return ok;
+  }
+
+  bool CombinedJson::read(string contractName, ContractInfo &info) {
+    info.contractName = "";
+    info.constantFunctionSrcmap.clear();
+    return readObject([&](const string &key) {
+      if (key == "contracts") return readObject([&](const string &name) {
+        if (!info.contractName.empty() || !boost::ends_with(name, contractName)) return skipValue();
+        info.contractName = name;
+        return readContract(info);
+      });
+      if (key == "sources") return readObject([&](const string &) {
+        return readObject([&](const string &field) {
+          return field == "AST" ? readNode(info.constantFunctionSrcmap) : skipValue();
+        });
+      });
+      return skipValue();
+    });
+  }
+
+  /* Cache layout: magic, hash of the json, requested name, then the ContractInfo fields */
+  static const uint32_t CACHE_MAGIC = 0x53464331;
+
+  static void writeString(ofstream &out, const string &s) {
+    uint64_t size = s.size();
+    out.write((const char *) &size, sizeof(size));
+    out.write(s.data(), size);
+  }
+
+  /* Bytes left after the read position, a size beyond it means a corrupted cache */
+  static uint64_t remaining(ifstream &in) {
+    auto pos = in.tellg();
+    in.seekg(0, ios::end);
+    auto size = in.tellg();
+    in.seekg(pos);
+    return pos < 0 || size < pos ? 0 : (uint64_t) (size - pos);
+  }
+
+  static bool readCachedString(ifstream &in, string &s) {
+    uint64_t size = 0;
+    if (!in.read((char *) &size, sizeof(size)) || size > remaining(in)) return false;
+    s.resize(size);
+    return (bool) in.read(&s[0], size);
+  }
+
+  bool loadContractCache(string cacheFile, uint64_t hash, string contractName, ContractInfo &info) {
+    ifstream in(cacheFile, ios::binary);
+    if (!in.is_open()) return false;
+    uint32_t magic = 0;
+    uint64_t cachedHash = 0;
+    string cachedName;
+    in.read((char *) &magic, sizeof(magic));
+    in.read((char *) &cachedHash, sizeof(cachedHash));
+    if (!in || magic != CACHE_MAGIC || cachedHash != hash) return false;
+    if (!readCachedString(in, cachedName) || cachedName != contractName) return false;
+    uint64_t count = 0;
+    auto ok = readCachedString(in, info.abiJson)
+      && readCachedString(in, info.bin)
+      && readCachedString(in, info.binRuntime)
+      && readCachedString(in, info.contractName)
+      && readCachedString(in, info.srcmap)
+      && readCachedString(in, info.srcmapRuntime)
+      && in.read((char *) &count, sizeof(count));
+    /* Every source range takes at least its size */
+    if (!ok || count > remaining(in) / sizeof(uint64_t)) return false;
+    info.constantFunctionSrcmap.resize(count);
+    for (auto &src : info.constantFunctionSrcmap) {
+      if (!readCachedString(in, src)) return false;
+    }
+    return true;
+  }
+
+  /* Written aside and renamed, concurrent fuzzers never read half a cache */
+  void saveContractCache(string cacheFile, uint64_t hash, string contractName, const ContractInfo &info) {
+    auto tmpFile = cacheFile + "." + to_string(getpid());
+    {
+      ofstream out(tmpFile, ios::binary | ios::trunc);
+      if (!out.is_open()) return;
+      out.write((const char *) &CACHE_MAGIC, sizeof(CACHE_MAGIC));
+      out.write((const char *) &hash, sizeof(hash));
+      writeString(out, contractName);
+      writeString(out, info.abiJson);
+      writeString(out, info.bin);
+      writeString(out, info.binRuntime);
+      writeString(out, info.contractName);
+      writeString(out, info.srcmap);
+      writeString(out, info.srcmapRuntime);
+      uint64_t count = info.constantFunctionSrcmap.size();
+      out.write((const char *) &count, sizeof(count));
+      for (auto &src : info.constantFunctionSrcmap) writeString(out, src);
+      if (!out) {
+        out.close();
+        remove(tmpFile.c_str());
+        return;
+      }
+    }
+    if (rename(tmpFile.c_str(), cacheFile.c_str())) remove(tmpFile.c_str());
+  }
+}
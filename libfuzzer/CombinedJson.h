@@ -0,0 +1,35 @@
+#pragma once
+#include "Common.h"
+#include "Util.h"
+#include "Fuzzer.h"
+
+using namespace std;
+
+namespace fuzzer {
+  /*
+   * Single pass reader of solc --combined-json output. Only the fields of the first
+   * contract whose name ends with contractName and the src of constant functions in
+   * the legacy ASTs are kept, everything else is skipped without building a tree
+   */
+  class CombinedJson {
+      const char *p;
+      const char *end;
+      void whitespace();
+      bool consume(char c);
+      bool readHex4(const char *from, uint32_t &out);
+      bool readString(string *out);
+      bool readBool(bool &out);
+      bool skipValue();
+      bool readObject(function<bool (const string &)> onKey);
+      bool readArray(function<bool ()> onItem);
+      bool readContract(ContractInfo &info);
+      bool readNode(vector<string> &constantFunctionSrcmap);
+    public:
+      CombinedJson(const string &json): p(json.data()), end(json.data() + json.size()) {}
+      /* False if the json is malformed, info.contractName is empty if no contract matched */
+      bool read(string contractName, ContractInfo &info);
+  };
+  /* Binary copy of a ContractInfo, valid while its json file hashes to the same value */
+  bool loadContractCache(string cacheFile, uint64_t hash, string contractName, ContractInfo &info);
+  void saveContractCache(string cacheFile, uint64_t hash, string contractName, const ContractInfo &info);
+}
@@ -303,7 +303,12 @@ namespace fuzzer {
         }
         for (auto inputNode : inputNodes) {
           string type = inputNode.second.get<string>("type");
-          tds.push_back(TypeDef(type));
+          TypeDef td(type);
+          td.argName = inputNode.second.get<string>("name", "");
+          /* Solidity declares "contract Token" for a parameter of type Token */
+          auto internalType = inputNode.second.get<string>("internalType", "");
+          if (boost::starts_with(internalType, "contract ")) td.contractType = internalType.substr(9);
+          tds.push_back(td);
         }
         this->fds.push_back(FuncDef(name, tds, payable));
       }
@@ -316,6 +321,37 @@ namespace fuzzer {
     return bytes(0, 0);
   }
   
+  void ContractABI::wireConstructor(const vector<DeployedContract> &deployed) {
+    if (deployed.empty()) return;
+    auto it = find_if(fds.begin(), fds.end(), [](FuncDef fd) { return fd.name == "";});
+    if (it == fds.end()) return;
+    /* "_token" and "tokenAddress" name a Token */
+    auto normalize = [](string name) {
+      boost::to_lower(name);
+      boost::erase_all(name, "_");
+      return name;
+    };
+    auto matches = [&](const TypeDef &td, const DeployedContract &contract) {
+      if (td.contractType.size()) return td.contractType == contract.name;
+      auto argName = normalize(td.argName);
+      auto name = normalize(contract.name);
+      return argName.size() && name.size() && (argName.find(name) != string::npos || name.find(argName) != string::npos);
+    };
+    vector<bool> used(deployed.size(), false);
+    for (auto &td : it->tds) {
+      if (!boost::starts_with(td.name, "address") || td.dimensions.size()) continue;
+      for (size_t idx = 0; idx < deployed.size(); idx ++) {
+        if (used[idx] || !matches(td, deployed[idx])) continue;
+        used[idx] = true;
+        bytes word(12, 0);
+        auto address = deployed[idx].addr.asBytes();
+        word.insert(word.end(), address.begin(), address.end());
+        td.addValue(word);
+        break;
+      }
+    }
+  }
+  
   bool ContractABI::isPayable(string name) {
     for (auto fd : fds) {
       if (fd.name == name) return fd.payable;
@@ -21,6 +21,9 @@ namespace fuzzer {
   
   struct TypeDef {
     string name;
+    /* Parameter name and contract of an address parameter as declared in the ABI, may be empty */
+    string argName;
+    string contractType;
     string fullname;
     string realname;
     bool padLeft;
@@ -40,6 +43,12 @@ namespace fuzzer {
     vector<vector<DataType>> dtss;
   };
   
+  /* Contract deployed before the one being deployed, by its name */
+  struct DeployedContract {
+    string name;
+    Address addr;
+  };
+
   struct FuncDef {
     string name;
     bool payable;
@@ -63,6 +72,11 @@ namespace fuzzer {
       bytes randomTestcase();
       /* Update then call encodeConstructor/encodeFunction to feed to evm */
       void updateTestData(bytes data);
+      /*
+       * Pass deployed contracts to the address arguments of the constructor whose declared
+       * contract or name matches theirs, each contract to one argument. Others stay as they are
+       */
+      void wireConstructor(const vector<DeployedContract> &deployed);
       /* Standard Json */
       string toStandardJson();
       uint64_t totalFuncs();
@@ -1,4 +1,6 @@
 #include <set>
+#include <algorithm>
+#include <unordered_set>
 #include "Dictionary.h"
 
 using namespace std;
@@ -37,4 +39,109 @@ namespace fuzzer {
       extras.push_back(d);
     }
   }
+
+  void AutoDictionary::add(u256 value, const string &branch) {
+    if (!value) return;
+    h256 key(value);
+    auto &entry = entries[key];
+    entry.hits ++;
+    if (branch.size()) {
+      auto &keys = branchEntries[branch];
+      if (keys.size() < AUTO_DICT_BRANCH_MAX && find(keys.begin(), keys.end(), key) == keys.end()) {
+        keys.push_back(key);
+      }
+    }
+    if (entries.size() > 2 * AUTO_DICT_MAX) prune();
+  }
+
+  void AutoDictionary::addWords(const bytes &memory, const u256 &offset, const u256 &size) {
+    if (offset >= memory.size() || size > memory.size() - offset) return;
+    auto begin = (uint64_t) offset;
+    auto end = begin + (uint64_t) size;
+    for (auto idx = begin; idx + 32 <= end; idx += 32) {
+      add(fromBigEndian<u256>(bytesConstRef(memory.data() + idx, 32)));
+    }
+  }
+
+  /* Hits add up, branch operands are appended in the order of other */
+  void AutoDictionary::merge(const AutoDictionary &other) {
+    for (auto &it : other.entries) entries[it.first].hits += it.second.hits;
+    for (auto &it : other.branchEntries) {
+      auto &keys = branchEntries[it.first];
+      for (auto &key : it.second) {
+        if (keys.size() < AUTO_DICT_BRANCH_MAX && find(keys.begin(), keys.end(), key) == keys.end()) {
+          keys.push_back(key);
+        }
+      }
+    }
+    if (entries.size() > 2 * AUTO_DICT_MAX) prune();
+  }
+
+  void AutoDictionary::clear() {
+    entries.clear();
+    branchEntries.clear();
+  }
+
+  void AutoDictionary::save(CheckpointWriter &w) const {
+    w.u64(entries.size());
+    for (auto &it : entries) {
+      w.word(u256(it.first));
+      w.u64(it.second.hits);
+    }
+    w.u64(branchEntries.size());
+    for (auto &it : branchEntries) {
+      w.str(it.first);
+      w.u64(it.second.size());
+      for (auto &key : it.second) w.word(u256(key));
+    }
+  }
+
+  void AutoDictionary::restore(CheckpointReader &r) {
+    clear();
+    auto numEntries = r.count();
+    for (uint64_t i = 0; i < numEntries && r.good(); i ++) {
+      h256 key(r.word());
+      entries[key].hits = r.u64();
+    }
+    auto numBranches = r.count();
+    for (uint64_t i = 0; i < numBranches && r.good(); i ++) {
+      auto &keys = branchEntries[r.str()];
+      auto numKeys = r.count();
+      for (uint64_t j = 0; j < numKeys && r.good(); j ++) keys.push_back(h256(r.word()));
+    }
+  }
+
+  /* Keep the AUTO_DICT_MAX most hit entries */
+  void AutoDictionary::prune() {
+    vector<pair<uint64_t, h256>> ranked;
+    for (auto it : entries) ranked.push_back(make_pair(it.second.hits, it.first));
+    nth_element(ranked.begin(), ranked.begin() + AUTO_DICT_MAX, ranked.end(), greater<pair<uint64_t, h256>>());
+    for (auto it = ranked.begin() + AUTO_DICT_MAX; it != ranked.end(); it ++) entries.erase(it->second);
+    for (auto &it : branchEntries) {
+      auto &keys = it.second;
+      keys.erase(remove_if(keys.begin(), keys.end(), [&](const h256 &key) { return !entries.count(key); }), keys.end());
+    }
+  }
+
+  vector<ExtraData> AutoDictionary::top(const string &branch, size_t count) const {
+    vector<ExtraData> extras;
+    unordered_set<h256> used;
+    auto push = [&](const h256 &key) {
+      if (extras.size() >= count || used.count(key)) return;
+      used.insert(key);
+      ExtraData d;
+      d.data = key.asBytes();
+      extras.push_back(d);
+    };
+    auto bIt = branchEntries.find(branch);
+    if (bIt != branchEntries.end()) {
+      for (auto &key : bIt->second) push(key);
+    }
+    vector<pair<uint64_t, h256>> ranked;
+    for (auto it : entries) ranked.push_back(make_pair(it.second.hits, it.first));
+    auto last = ranked.begin() + min(ranked.size(), count);
+    partial_sort(ranked.begin(), last, ranked.end(), greater<pair<uint64_t, h256>>());
+    for (auto it = ranked.begin(); it != last; it ++) push(it->second);
+    return extras;
+  }
 }
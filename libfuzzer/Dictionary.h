@@ -2,6 +2,7 @@
 #include <vector>
 #include "Common.h"
 #include "Util.h"
+#include "Checkpoint.h"
 
 using namespace std;
 using namespace dev;
@@ -17,4 +18,29 @@ namespace fuzzer {
       void fromCode(bytes code);
       void fromAddress(bytes address);
   };
+
+  /*
+  * Values seen while executing: comparison operands per branch, SHA3 and
+  * SLOAD words, CALLER and ADDRESS. Deduplicated, ranked by hits and capped
+  */
+  class AutoDictionary {
+      struct Entry {
+        uint64_t hits = 0;
+      };
+      unordered_map<h256, Entry> entries;
+      /* Operands compared right before the JUMPI of a branch */
+      unordered_map<string, vector<h256>> branchEntries;
+      void prune();
+    public:
+      void add(u256 value, const string &branch = "");
+      /* Whole words of memory[offset, offset + size), nothing when the range is not in memory */
+      void addWords(const bytes &memory, const u256 &offset, const u256 &size);
+      size_t size() const { return entries.size(); }
+      void merge(const AutoDictionary &other);
+      void clear();
+      void save(CheckpointWriter &w) const;
+      void restore(CheckpointReader &r);
+      /* Entries of the branch first, then the most hit ones, as 32 bytes words */
+      vector<ExtraData> top(const string &branch, size_t count) const;
+  };
 }
@@ -0,0 +1,112 @@
+#include "ExecutorPool.h"
+#include "Profiler.h"
+
+namespace fuzzer {
+  ExecutorPool::ExecutorPool(size_t size, const ForkSource *fork) {
+    /* Containers are built here, programs register seal engines on construction */
+    for (size_t i = 0; i < size; i ++) executors.push_back(unique_ptr<Executor>(new Executor(fork)));
+    for (auto &executor : executors) {
+      auto e = executor.get();
+      e->worker = thread([this, e] { work(e); });
+    }
+  }
+
+  ExecutorPool::~ExecutorPool() {
+    {
+      lock_guard<mutex> guard(lock);
+      stopping = true;
+    }
+    started.notify_all();
+    for (auto &executor : executors) executor->worker.join();
+  }
+
+  void ExecutorPool::deploy(bytes code, ContractABI ca, bytes data, Address addr, const vector<DeployedContract> &wired) {
+    for (auto &executor : executors) {
+      auto executive = executor->container.loadContract(code, ca, addr);
+      executive.wired = wired;
+      executive.deploy(data, EMPTY_ONOP);
+    }
+  }
+
+  void ExecutorPool::setAttacker(Address addr, AttackerStrategy strategy) {
+    for (auto &executor : executors) executor->container.setAttacker(addr, strategy);
+  }
+
+  void ExecutorPool::load(bytes code, ContractABI ca, const TargetExecutive &main) {
+    for (auto &executor : executors) {
+      executor->executive.reset(new TargetExecutive(executor->container.loadContract(code, ca, main.addr)));
+      executor->executive->gasBudget = main.gasBudget;
+      executor->executive->stepLimit = main.stepLimit;
+      executor->executive->countLoops = main.countLoops;
+      executor->executive->stateCoverage = main.stateCoverage;
+      executor->executive->wired = main.wired;
+      executor->executive->autoDict = main.autoDict ? &executor->autoDict : nullptr;
+    }
+  }
+
+  void ExecutorPool::work(Executor *executor) {
+    uint64_t seen = 0;
+    while (true) {
+      {
+        unique_lock<mutex> guard(lock);
+        started.wait(guard, [&] { return stopping || generation != seen; });
+        if (stopping) return;
+        seen = generation;
+      }
+      executor->results.clear();
+      if (executor->inputs.size()) executor->results = executor->executive->execBatch(executor->inputs, *validJumpis);
+      Profiler::merge();
+      {
+        lock_guard<mutex> guard(lock);
+        running --;
+      }
+      finished.notify_one();
+    }
+  }
+
+  vector<TargetContainerResult> ExecutorPool::execBatch(const vector<bytes> &batch, const vector<bool> &funcMask, const tuple<unordered_set<uint64_t>, unordered_set<uint64_t>> &_validJumpis) {
+    auto size = executors.size();
+    for (size_t i = 0; i < size; i ++) {
+      auto &executor = executors[i];
+      executor->inputs.assign(batch.begin() + i * batch.size() / size, batch.begin() + (i + 1) * batch.size() / size);
+      executor->executive->funcMask = funcMask;
+    }
+    {
+      lock_guard<mutex> guard(lock);
+      validJumpis = &_validJumpis;
+      running = size;
+      generation ++;
+    }
+    started.notify_all();
+    {
+      unique_lock<mutex> guard(lock);
+      finished.wait(guard, [&] { return !running; });
+    }
+    vector<TargetContainerResult> results;
+    for (auto &executor : executors) {
+      results.insert(results.end(), executor->results.begin(), executor->results.end());
+    }
+    return results;
+  }
+
+  void ExecutorPool::mergeAutoDictionary(AutoDictionary &dict) {
+    for (auto &executor : executors) {
+      dict.merge(executor->autoDict);
+      executor->autoDict.clear();
+    }
+  }
+
+  void ExecutorPool::analyze(vector<bool> &vulnerabilities, vector<OracleFinding> &findings) {
+    for (auto &executor : executors) {
+      auto flags = executor->container.analyze();
+      auto executorFindings = executor->container.findings();
+      for (size_t i = 0; i < flags.size() && i < vulnerabilities.size(); i ++) {
+        vulnerabilities[i] = vulnerabilities[i] || flags[i];
+      }
+      for (auto &finding : executorFindings) {
+        auto found = any_of(findings.begin(), findings.end(), [&](const OracleFinding &f) { return f.oracle == finding.oracle; });
+        if (!found) findings.push_back(finding);
+      }
+    }
+  }
+}
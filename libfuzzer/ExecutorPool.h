@@ -0,0 +1,54 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "TargetContainer.h"
+#include "Dictionary.h"
+
+using namespace dev;
+using namespace eth;
+using namespace std;
+
+namespace fuzzer {
+  /*
+   * Executors with private containers, each runs one contiguous slice of a batch
+   * on its own thread. Results come back in input order, so merging them into the
+   * leaders is as deterministic as executing the batch serially
+   */
+  class ExecutorPool {
+      struct Executor {
+        Executor(const ForkSource *fork): container(fork) {}
+        TargetContainer container;
+        unique_ptr<TargetExecutive> executive;
+        AutoDictionary autoDict;
+        vector<bytes> inputs;
+        vector<TargetContainerResult> results;
+        thread worker;
+      };
+      vector<unique_ptr<Executor>> executors;
+      const tuple<unordered_set<uint64_t>, unordered_set<uint64_t>> *validJumpis = nullptr;
+      mutex lock;
+      condition_variable started;
+      condition_variable finished;
+      uint64_t generation = 0;
+      size_t running = 0;
+      bool stopping = false;
+      void work(Executor *executor);
+    public:
+      ExecutorPool(size_t size, const ForkSource *fork);
+      ~ExecutorPool();
+      size_t size() const { return executors.size(); }
+      /* Deploy an asset contract into every executor at the address it has in the main container */
+      void deploy(bytes code, ContractABI ca, bytes data, Address addr, const vector<DeployedContract> &wired);
+      void setAttacker(Address addr, AttackerStrategy strategy);
+      /* Load the contract under test with the settings of the main executive */
+      void load(bytes code, ContractABI ca, const TargetExecutive &main);
+      vector<TargetContainerResult> execBatch(const vector<bytes> &batch, const vector<bool> &funcMask, const tuple<unordered_set<uint64_t>, unordered_set<uint64_t>> &validJumpis);
+      /* Move the values harvested by executors into dict, in executor order */
+      void mergeAutoDictionary(AutoDictionary &dict);
+      /* Add flags and findings of oracles which only fired inside executors */
+      void analyze(vector<bool> &vulnerabilities, vector<OracleFinding> &findings);
+  };
+}
@@ -17,4 +17,7 @@ namespace fuzzer {
     }
   };
   using OnMutateFunc = function<FuzzItem (bytes b)>;
+  using OnMutateBatchFunc = function<vector<FuzzItem> (const vector<bytes> &batch)>;
+  /* Item at an index of the corpus, only data and cksum are read */
+  using SampleFunc = function<FuzzItem (size_t idx)>;
 }
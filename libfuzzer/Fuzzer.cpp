@@ -6,6 +6,9 @@
 #include "Dictionary.h"
 #include "Logger.h"
 #include "BytecodeBranch.h"
+#include "Profiler.h"
+#include "Minimizer.h"
+#include "Checkpoint.h"
 
 using namespace dev;
 using namespace eth;
@@ -16,6 +19,14 @@ namespace pt = boost::property_tree;
 /* Setup virgin byte to 255 */
 Fuzzer::Fuzzer(FuzzParam fuzzParam): fuzzParam(fuzzParam){
   fill_n(fuzzStat.stageFinds, 32, 0);
+  if (fuzzParam.leaderStore.size()) store.open(fuzzParam.leaderStore);
+  if (fuzzParam.forkDb.size()) {
+    fork.reset(new ForkSource(fuzzParam.forkDb, h256(fuzzParam.forkRoot)));
+    if (!fork->hasRoot()) {
+      cout << "[x] No state root " << fuzzParam.forkRoot << " in " << fuzzParam.forkDb << endl;
+      exit(0);
+    }
+  }
 }
 
 /* Detect new exception */
@@ -29,17 +40,494 @@ void Fuzzer::updateTracebits(unordered_set<string> _tracebits) {
 }
 
 void Fuzzer::updatePredicates(unordered_map<string, u256> _pred) {
+  bool changed = false;
   for (auto it : _pred) {
-    predicates.insert(it.first);
+    changed = predicates.insert(it.first).second || changed;
   };
   // Remove covered predicates
   for(auto it = predicates.begin(); it != predicates.end(); ) {
     if (tracebits.count(*it)) {
       it = predicates.erase(it);
+      changed = true;
     } else {
       ++it;
     }
   }
+  if (changed) updateFuncMask();
+}
+
+/*
+ * Call the functions which reach an uncovered branch, functions with unknown reach
+ * and functions writing storage before a targeted one since they may set its state
+ */
+void Fuzzer::updateFuncMask() {
+  if (funcReaches.empty() || fuzzParam.objective == GAS) return;
+  /* Functions only reach runtime branches, the constructor runs for every input anyway */
+  unordered_set<uint64_t> uncovered;
+  for (auto predicate : predicates) {
+    auto pc = stoull(splitString(predicate, ':')[0]);
+    if (runtimeJumpis.count(pc)) uncovered.insert(pc);
+  }
+  funcMask.assign(funcReaches.size(), false);
+  bool hasTargetAfter = false;
+  for (int idx = funcReaches.size() - 1; idx >= 0; idx --) {
+    auto &reach = funcReaches[idx];
+    auto isTarget = any_of(reach.jumpis.begin(), reach.jumpis.end(), [&](uint64_t pc) { return uncovered.count(pc); });
+    funcMask[idx] = !reach.known || isTarget || (reach.writesState && hasTargetAfter);
+    hasTargetAfter = hasTargetAfter || isTarget;
+  }
+}
+
+/* Collect the verdict of every oracle */
+void Fuzzer::analyze(TargetContainer &container) {
+  vulnerabilities = container.analyze();
+  oracleNames = container.oracleNames();
+  findings = container.findings();
+  if (pool) pool->analyze(vulnerabilities, findings);
+}
+
+/*
+ * Save the test case of every new finding as a witness which --replay executes again.
+ * Minimizing it while its oracle still fires takes up to MINIMIZE_MAX_EXECS execs,
+ * so the fuzz loop only saves the test case and the end of the campaign minimizes
+ */
+void Fuzzer::saveFindings(TargetExecutive &te, const tuple<unordered_set<uint64_t>, unordered_set<uint64_t>> &validJumpis, bool minimize) {
+  auto funcMask = te.funcMask;
+  te.funcMask.clear();
+  for (auto &finding : findings) {
+    if (witnesses.count(finding.oracle) && (!minimize || minimizedWitnesses.count(finding.oracle))) continue;
+    Minimizer minimizer;
+    auto minimized = finding.testcase;
+    if (minimize) {
+      minimized = minimizer.minimize(finding.testcase, [&](const bytes &data) {
+        auto res = te.exec(ContractABI::postprocessTestData(data), validJumpis);
+        return res.oracleHits.count(finding.oracle) > 0;
+      });
+      minimizedWitnesses.insert(finding.oracle);
+    }
+    auto folder = mainContract().contractName + "/findings/";
+    auto file = folder + boost::replace_all_copy(finding.oracle, " ", "_") + ".json";
+    boost::filesystem::create_directories(folder);
+    pt::ptree root;
+    root.put("oracle", finding.oracle);
+    root.put("function", finding.functionIdx);
+    root.put("pc", finding.pc);
+    root.put("testcase", toHex(finding.testcase));
+    root.put("minimized", toHex(ContractABI::postprocessTestData(minimized)));
+    root.put("minimizeExecs", minimizer.execs);
+    pt::write_json(file, root);
+    witnesses[finding.oracle] = file;
+    Logger::debug("Witness of " + finding.oracle + " in " + file);
+  }
+  te.funcMask = funcMask;
+}
+
+uint32_t Fuzzer::branchId(const string &branch) {
+  auto it = branchIds.find(branch);
+  if (it != branchIds.end()) return it->second;
+  uint32_t id = branchIds.size();
+  branchIds[branch] = id;
+  return id;
+}
+
+/* Smallest set of leaders found by greedy set cover which keeps every covered branch */
+void Fuzzer::updateCorpus() {
+  if (!corpusDirty) return;
+  vector<vector<uint32_t>> sets;
+  for (auto &branch : queues) sets.push_back(leaders.at(branch).branches);
+  corpus.clear();
+  for (auto idx : Minimizer::cover(sets)) corpus.push_back(queues[idx]);
+  corpusDirty = false;
+}
+
+Leader Fuzzer::makeLeader(const FuzzItem &item, u256 comparisonValue) {
+  Leader leader(store.add(item.data), item, comparisonValue);
+  for (auto &tracebit : item.res.tracebits) leader.branches.push_back(branchId(tracebit));
+  return leader;
+}
+
+/* The test case of a removed leader is freed once no other leader shares it */
+void Fuzzer::eraseLeader(const string &key) {
+  auto it = leaders.find(key);
+  if (it == leaders.end()) return;
+  store.release(it->second.input);
+  leaders.erase(it);
+}
+
+FuzzItem Fuzzer::leaderItem(const string &branch) {
+  auto &leader = leaders.at(branch);
+  FuzzItem item(store.get(leader.input));
+  item.res.cksum = leader.cksum;
+  if (leader.comparisonValue != 0) item.res.predicates[branch] = leader.comparisonValue;
+  item.fuzzedCount = leader.fuzzedCount;
+  item.depth = leader.depth;
+  return item;
+}
+
+/*
+ * Shorten and zero the test case of a leader while it keeps the branch: covered
+ * for a covered branch, no farther from it for an uncovered one. The candidates
+ * are saved like any executed input once the leader is trimmed
+ */
+void Fuzzer::trimLeader(TargetExecutive &te, const string &branch, const tuple<unordered_set<uint64_t>, unordered_set<uint64_t>> &validJumpis) {
+  auto &leader = leaders.at(branch);
+  leader.trimmed = true;
+  auto origin = store.get(leader.input);
+  auto depth = leader.depth;
+  FuzzItem trimmed(origin);
+  vector<FuzzItem> candidates;
+  auto funcMask = te.funcMask;
+  te.funcMask.clear();
+  Minimizer minimizer(TRIM_MAX_EXECS);
+  minimizer.trim(origin, [&](const bytes &data) {
+    FuzzItem candidate(ContractABI::postprocessTestData(data));
+    candidate.res = te.exec(candidate.data, validJumpis);
+    auto it = candidate.res.predicates.find(branch);
+    auto kept = leader.comparisonValue == 0
+      ? candidate.res.tracebits.count(branch) > 0
+      : it != candidate.res.predicates.end() && it->second <= leader.comparisonValue;
+    if (kept) trimmed = candidate;
+    candidates.push_back(candidate);
+    return kept;
+  });
+  te.funcMask = funcMask;
+  if (trimmed.data != origin) {
+    fuzzStat.trimmedBytes += origin.size() - trimmed.data.size();
+    auto trimmedLeader = makeLeader(trimmed, leader.comparisonValue);
+    store.release(leader.input);
+    leader.input = trimmedLeader.input;
+    leader.cksum = trimmedLeader.cksum;
+    leader.branches = trimmedLeader.branches;
+    corpusDirty = true;
+  }
+  /* Branches, predicates, exceptions and hangs the candidates reached */
+  for (auto &candidate : candidates) saveItem(candidate, depth, isSlowInput(te, candidate, validJumpis));
+}
+
+/* Leaders besides branches are keyed by "gas:<transaction>", "loop:<pc>" and "state:<entry>" */
+static bool isBranch(const string &key) {
+  return key.size() && isdigit(key[0]);
+}
+
+/* Make item the leader of a feedback key other than a branch */
+void Fuzzer::promoteLeader(const string &key, FuzzItem &item, uint64_t depth) {
+  eraseLeader(key);
+  if (find(queues.begin(), queues.end(), key) == queues.end()) queues.push_back(key);
+  item.depth = depth + 1;
+  leaders.insert(make_pair(key, makeLeader(item, 0)));
+  corpusDirty = true;
+  if (depth + 1 > fuzzStat.maxdepth) fuzzStat.maxdepth = depth + 1;
+  fuzzStat.lastNewPath = timer.elapsed();
+  Logger::debug("Increase " + key);
+  Logger::debug(Logger::testFormat(item.data));
+}
+
+/*
+ * An input which makes a transaction use more gas or a loop iterate into a
+ * higher power of two than seen before becomes the leader of that transaction or loop
+ */
+void Fuzzer::saveGas(FuzzItem &item, uint64_t depth) {
+  auto &gasUsed = item.res.gasUsed;
+  if (maxGas.size() < gasUsed.size()) maxGas.resize(gasUsed.size(), 0);
+  for (size_t idx = 0; idx < gasUsed.size(); idx ++) {
+    if (gasUsed[idx] <= maxGas[idx]) continue;
+    maxGas[idx] = gasUsed[idx];
+    promoteLeader("gas:" + to_string(idx), item, depth);
+  }
+  for (auto it : item.res.loopIterations) {
+    int bucket = 64 - __builtin_clzll(it.second);
+    auto &maxBucket = loopBuckets[it.first];
+    if (bucket <= maxBucket) continue;
+    maxBucket = bucket;
+    promoteLeader("loop:" + to_string(it.first), item, depth);
+  }
+}
+
+/* An input reaching a storage state not seen before becomes its leader */
+void Fuzzer::saveStates(FuzzItem &item, uint64_t depth) {
+  if (stateMap.empty()) stateMap.assign(STATE_MAP_SIZE, false);
+  for (auto idx : item.res.stateBits) {
+    if (stateMap[idx]) continue;
+    stateMap[idx] = true;
+    fuzzStat.states ++;
+    promoteLeader("state:" + to_string(idx), item, depth);
+  }
+}
+
+/* Bumped whenever the layout below changes */
+static const uint64_t CHECKPOINT_VERSION = 3;
+/* Exit status of a campaign which can not be resumed, stop() ends a campaign with 1 */
+static const int CHECKPOINT_EXIT = 2;
+
+/*
+ * Everything the fuzz loop needs to continue: statistics, queue position,
+ * leaders with their test cases, the feedback maps and the dictionary
+ */
+bytes Fuzzer::checkpoint() {
+  CheckpointWriter w;
+  auto bin = mainContract().bin;
+  w.u64(CHECKPOINT_VERSION);
+  w.u64(hashBytes((const byte *) bin.data(), bin.size()));
+  w.u64(fuzzStat.idx);
+  w.u64(fuzzStat.maxdepth);
+  w.u64(fuzzStat.totalExecs);
+  w.u64(fuzzStat.queueCycle);
+  for (int i = 0; i < 32; i ++) w.u64(fuzzStat.stageFinds[i]);
+  for (int i = 0; i < 32; i ++) w.u64(Mutation::stageCycles[i]);
+  w.real(fuzzStat.avgExecTime);
+  w.u64(fuzzStat.slowExecs);
+  w.u64(fuzzStat.trimmedBytes);
+  w.u64(fuzzStat.states);
+  w.u64(execRounds);
+  w.strings(queues);
+  w.u64(leaders.size());
+  for (auto &it : leaders) {
+    auto &leader = it.second;
+    w.str(it.first);
+    w.data(store.get(leader.input));
+    w.u64(leader.cksum);
+    w.u64(leader.branches.size());
+    for (auto id : leader.branches) w.u64(id);
+    w.u64(leader.fuzzedCount);
+    w.u64(leader.depth);
+    w.word(leader.comparisonValue);
+    w.data(leader.influence);
+    w.u64(leader.influenceInferred);
+    w.u64(leader.trimmed);
+  }
+  w.u64(branchIds.size());
+  for (auto &it : branchIds) {
+    w.str(it.first);
+    w.u64(it.second);
+  }
+  w.strings(tracebits);
+  w.strings(predicates);
+  w.strings(uniqExceptions);
+  w.strings(uniqHangs);
+  w.u64(quarantine.size());
+  for (auto cksum : quarantine) w.u64(cksum);
+  w.u64(witnesses.size());
+  for (auto &it : witnesses) {
+    w.str(it.first);
+    w.str(it.second);
+  }
+  w.u64(maxGas.size());
+  for (auto &gas : maxGas) w.word(gas);
+  w.u64(loopBuckets.size());
+  for (auto &it : loopBuckets) {
+    w.u64(it.first);
+    w.u64(it.second);
+  }
+  /* Only the reached entries of the state map */
+  vector<uint64_t> states;
+  for (size_t idx = 0; idx < stateMap.size(); idx ++) {
+    if (stateMap[idx]) states.push_back(idx);
+  }
+  w.u64(states.size());
+  for (auto idx : states) w.u64(idx);
+  /* The timer starts over on resume, the plateau is measured from the age of the last new path */
+  w.real(timer.elapsed() - fuzzStat.lastNewPath);
+  w.strings(minimizedWitnesses);
+  autoDict.save(w);
+  return w.out();
+}
+
+void Fuzzer::restore(const bytes &data) {
+  CheckpointReader r(data);
+  auto bin = mainContract().bin;
+  if (r.u64() != CHECKPOINT_VERSION || r.u64() != hashBytes((const byte *) bin.data(), bin.size())) {
+    cout << "[x] Checkpoint " << fuzzParam.checkpoint << " is not a campaign of this contract" << endl;
+    exit(CHECKPOINT_EXIT);
+  }
+  fuzzStat.idx = r.u64();
+  fuzzStat.maxdepth = r.u64();
+  fuzzStat.totalExecs = r.u64();
+  fuzzStat.queueCycle = r.u64();
+  for (int i = 0; i < 32; i ++) fuzzStat.stageFinds[i] = r.u64();
+  for (int i = 0; i < 32; i ++) Mutation::stageCycles[i] = r.u64();
+  fuzzStat.avgExecTime = r.real();
+  fuzzStat.slowExecs = r.u64();
+  fuzzStat.trimmedBytes = r.u64();
+  fuzzStat.states = r.u64();
+  execRounds = r.u64();
+  queues = r.strings();
+  auto numLeaders = r.count();
+  for (uint64_t i = 0; i < numLeaders && r.good(); i ++) {
+    auto key = r.str();
+    FuzzItem item(r.data());
+    item.res.cksum = r.u64();
+    Leader leader(store.add(item.data), item, 0);
+    leader.branches.resize(r.count());
+    for (auto &id : leader.branches) id = r.u64();
+    leader.fuzzedCount = r.u64();
+    leader.depth = r.u64();
+    leader.comparisonValue = r.word();
+    leader.influence = r.data();
+    leader.influenceInferred = r.u64();
+    leader.trimmed = r.u64();
+    leaders.insert(make_pair(key, leader));
+  }
+  auto numBranchIds = r.count();
+  for (uint64_t i = 0; i < numBranchIds && r.good(); i ++) {
+    auto branch = r.str();
+    branchIds[branch] = r.u64();
+  }
+  for (auto &tracebit : r.strings()) tracebits.insert(tracebit);
+  for (auto &predicate : r.strings()) predicates.insert(predicate);
+  for (auto &exception : r.strings()) uniqExceptions.insert(exception);
+  for (auto &hang : r.strings()) uniqHangs.insert(hang);
+  auto numQuarantined = r.count();
+  for (uint64_t i = 0; i < numQuarantined && r.good(); i ++) quarantine.insert(r.u64());
+  auto numWitnesses = r.count();
+  for (uint64_t i = 0; i < numWitnesses && r.good(); i ++) {
+    auto oracle = r.str();
+    witnesses[oracle] = r.str();
+  }
+  maxGas.resize(r.count());
+  for (auto &gas : maxGas) gas = r.word();
+  auto numLoops = r.count();
+  for (uint64_t i = 0; i < numLoops && r.good(); i ++) {
+    auto pc = r.u64();
+    loopBuckets[pc] = r.u64();
+  }
+  auto numStates = r.count();
+  if (numStates) stateMap.assign(STATE_MAP_SIZE, false);
+  for (uint64_t i = 0; i < numStates && r.good(); i ++) stateMap[r.u64() % STATE_MAP_SIZE] = true;
+  fuzzStat.lastNewPath = timer.elapsed() - r.real();
+  for (auto &oracle : r.strings()) minimizedWitnesses.insert(oracle);
+  autoDict.restore(r);
+  auto isQueued = all_of(queues.begin(), queues.end(), [&](const string &key) { return leaders.count(key); });
+  if (!r.good() || !isQueued || fuzzStat.idx >= (int) queues.size()) {
+    cout << "[x] Checkpoint " << fuzzParam.checkpoint << " is corrupted" << endl;
+    exit(CHECKPOINT_EXIT);
+  }
+  corpusDirty = true;
+  updateFuncMask();
+}
+
+/*
+ * The campaign is serialized here and written by a thread, the fuzz loop goes on
+ * meanwhile. While the previous checkpoint is still being written none is started
+ */
+void Fuzzer::saveCheckpoint(bool background) {
+  if (checkpointWriting) {
+    if (background && !checkpointDone) return;
+    checkpointWriter.join();
+    checkpointWriting = false;
+  }
+  lastCheckpoint = timer.elapsed();
+  auto data = checkpoint();
+  auto file = fuzzParam.checkpoint;
+  auto write = [this, file](const bytes &buffer) {
+    if (!writeCheckpoint(file, buffer)) Logger::info("Can not write checkpoint " + file);
+    checkpointDone = true;
+  };
+  if (!background) {
+    write(data);
+    return;
+  }
+  checkpointDone = false;
+  checkpointWriting = true;
+  checkpointWriter = thread(write, move(data));
+}
+
+/*
+ * Publish the leaders of newly covered branches and execute the entries of peers
+ * which cover a branch not covered here, they become leaders like any other input
+ */
+void Fuzzer::syncLeaders(TargetExecutive &te, const tuple<unordered_set<uint64_t>, unordered_set<uint64_t>> &validJumpis) {
+  for (auto &key : queues) {
+    auto &leader = leaders.at(key);
+    if (!isBranch(key) || leader.comparisonValue != 0 || synced.count(key)) continue;
+    synced.insert(key);
+    sync->publish(SyncDir::branchKey(key), store.get(leader.input));
+  }
+  vector<bytes> batch;
+  for (auto &entry : sync->take()) {
+    if (!tracebits.count(SyncDir::branchOf(entry.branch))) batch.push_back(entry.input);
+  }
+  if (batch.empty()) return;
+  auto numLeaders = leaders.size();
+  saveIfInterestBatch(te, batch, 0, validJumpis);
+  fuzzStat.stageFinds[STAGE_SYNC] += leaders.size() - numLeaders;
+  Logger::debug("Imported " + to_string(batch.size()) + " entries of peers");
+}
+
+/* Keep the average exec time and detect outliers */
+bool Fuzzer::isSlowExec(double execTime) {
+  fuzzStat.avgExecTime += (execTime - fuzzStat.avgExecTime) / (fuzzStat.totalExecs + 1);
+  return isOutlier(execTime);
+}
+
+bool Fuzzer::isOutlier(double execTime) const {
+  if (fuzzStat.totalExecs < SLOW_EXEC_WARMUP) return false;
+  return execTime > max(SLOW_EXEC_MIN, SLOW_EXEC_FACTOR * fuzzStat.avgExecTime);
+}
+
+/*
+ * One slow sample can be noise of the machine, the input is executed again and only
+ * slow if both runs are. Slow inputs are what the gas objective looks for
+ */
+bool Fuzzer::isSlowInput(TargetExecutive &te, const FuzzItem &item, const tuple<unordered_set<uint64_t>, unordered_set<uint64_t>> &validJumpis) {
+  if (!isSlowExec(item.res.execTime) || fuzzParam.objective == GAS) return false;
+  return isOutlier(te.exec(item.data, validJumpis).execTime);
+}
+
+/*
+ * Assets in the order they are deployed: those taking fewer addresses in their
+ * constructor first so the others can be wired to them, the contract under test last
+ */
+vector<ContractInfo> Fuzzer::deploymentOrder() {
+  auto contractInfo = fuzzParam.contractInfo;
+  auto rank = [](const ContractInfo &c) {
+    if (c.isMain) return numeric_limits<size_t>::max();
+    ContractABI ca(c.abiJson);
+    auto it = find_if(ca.fds.begin(), ca.fds.end(), [](const FuncDef &fd) { return fd.name == ""; });
+    if (it == ca.fds.end()) return (size_t) 0;
+    return (size_t) count_if(it->tds.begin(), it->tds.end(), [](const TypeDef &td) {
+      return boost::starts_with(td.name, "address") && td.dimensions.empty();
+    });
+  };
+  stable_sort(contractInfo.begin(), contractInfo.end(), [&](const ContractInfo &a, const ContractInfo &b) {
+    return rank(a) < rank(b);
+  });
+  return contractInfo;
+}
+
+/* Executive of a contract of deploymentOrder at its address, with the budgets of the campaign */
+TargetExecutive Fuzzer::loadExecutive(TargetContainer &container, const ContractInfo &contractInfo) {
+  auto isAttacker = contractInfo.contractName.find(fuzzParam.attackerName) != string::npos;
+  auto addr = contractInfo.isMain ? CONTRACT_ADDRESS : isAttacker ? ATTACKER_ADDRESS : ASSET_ADDRESS;
+  auto executive = container.loadContract(fromHex(contractInfo.bin), ContractABI(contractInfo.abiJson), Address(addr));
+  if (fuzzParam.gasBudget) executive.gasBudget = fuzzParam.gasBudget;
+  executive.stepLimit = fuzzParam.stepLimit;
+  return executive;
+}
+
+/*
+ * Deploy an asset or the attacker agent with a random testcase, wired to the assets
+ * deployed before it. Mutations pass its address to the contract under test, only
+ * assets are wired into constructors
+ */
+Address Fuzzer::deployAsset(TargetContainer &container, const ContractInfo &contractInfo, vector<DeployedContract> &deployed) {
+  auto isAttacker = contractInfo.contractName.find(fuzzParam.attackerName) != string::npos;
+  ContractABI ca(contractInfo.abiJson);
+  auto bin = fromHex(contractInfo.bin);
+  auto executive = loadExecutive(container, contractInfo);
+  auto revisedData = ContractABI::postprocessTestData(ca.randomTestcase());
+  executive.wired = deployed;
+  executive.deploy(revisedData, EMPTY_ONOP);
+  if (pool) pool->deploy(bin, ca, revisedData, executive.addr, deployed);
+  if (isAttacker) {
+    container.setAttacker(executive.addr, fuzzParam.attackerStrategy);
+    if (pool) pool->setAttacker(executive.addr, fuzzParam.attackerStrategy);
+  } else {
+    DeployedContract contract;
+    contract.name = contractInfo.contractName;
+    contract.addr = executive.addr;
+    deployed.push_back(contract);
+  }
+  return executive.addr;
 }
 
 ContractInfo Fuzzer::mainContract() {
@@ -93,14 +581,18 @@ void Fuzzer::showStats(const Mutation &mutation, const tuple<unordered_set<uint6
   auto dictionary = padStr(dict1 + ", " + addrDict1, 30);
   auto hav1 = to_string(fuzzStat.stageFinds[STAGE_HAVOC]) + "/" + to_string(mutation.stageCycles[STAGE_HAVOC]);
   auto havoc = padStr(hav1, 30);
+  auto solve1 = to_string(fuzzStat.stageFinds[STAGE_SOLVE]) + "/" + to_string(mutation.stageCycles[STAGE_SOLVE]);
+  auto solver = padStr(solve1, 30);
   auto pending = padStr(to_string(leaders.size() - fuzzStat.idx - 1), 5);
   auto fav = count_if(leaders.begin(), leaders.end(), [](const pair<string, Leader> &p) {
-    return !p.second.item.fuzzedCount;
+    return !p.second.fuzzedCount;
   });
   auto pendingFav = padStr(to_string(fav), 5);
   auto maxdepthStr = padStr(to_string(fuzzStat.maxdepth), 5);
   auto exceptionCount = padStr(to_string(uniqExceptions.size()), 5);
+  auto hangCount = padStr(to_string(uniqHangs.size()), 5);
   auto predicateSize = padStr(to_string(predicates.size()), 5);
+  auto slowExecs = padStr(to_string(fuzzStat.slowExecs), 15);
   auto contract = mainContract();
   auto toResult = [](bool val) { return val ? "found" : "none "; };
   printf(cGRN Bold "%sAFL Solidity v0.0.1 (%s)" cRST "\n", padStr("", 10).c_str(), contract.contractName.substr(0, 20).c_str());
@@ -111,7 +603,7 @@ void Fuzzer::showStats(const Mutation &mutation, const tuple<unordered_set<uint6
   printf(bH "  now trying : %s" bH " cycles done : %s" bH "\n", nowTrying.c_str(), cycleDone.c_str());
   printf(bH " stage execs : %s" bH "    branches : %s" bH "\n", stageExec.c_str(), numBranches.c_str());
   printf(bH " total execs : %s" bH "    coverage : %s" bH "\n", allExecs.c_str(), coverage.c_str());
-  printf(bH "  exec speed : %s" bH "               %s" bH "\n", execSpeed.c_str(), padStr("", 15).c_str());
+  printf(bH "  exec speed : %s" bH "  slow execs : %s" bH "\n", execSpeed.c_str(), slowExecs.c_str());
   printf(bH "  cycle prog : %s" bH "               %s" bH "\n", cycleProgress.c_str(), padStr("", 15).c_str());
   printf(bLTR bV5 cGRN " fuzzing yields " cRST bV5 bV5 bV5 bV2 bV bBTR bV10 bV bTTR bV cGRN " path geometry " cRST bV2 bV2 bRTR "\n");
   printf(bH "   bit flips : %s" bH "     pending : %s" bH "\n", bitflip.c_str(), pending.c_str());
@@ -119,13 +611,19 @@ void Fuzzer::showStats(const Mutation &mutation, const tuple<unordered_set<uint6
   printf(bH " arithmetics : %s" bH "   max depth : %s" bH "\n", arithmetic.c_str(), maxdepthStr.c_str());
   printf(bH "  known ints : %s" bH " uniq except : %s" bH "\n", knownInts.c_str(), exceptionCount.c_str());
   printf(bH "  dictionary : %s" bH "  predicates : %s" bH "\n", dictionary.c_str(), predicateSize.c_str());
-  printf(bH "       havoc : %s" bH "               %s" bH "\n", havoc.c_str(), padStr("", 5).c_str());
+  printf(bH "       havoc : %s" bH "  uniq hangs : %s" bH "\n", havoc.c_str(), hangCount.c_str());
+  printf(bH "      solver : %s" bH "               %s" bH "\n", solver.c_str(), padStr("", 5).c_str());
   printf(bLTR bV5 cGRN " oracle yields " cRST bV bV10 bV5 bV bTTR bV2 bV10 bV bBTR bV bV2 bV5 bV5 bV2 bV2 bV5 bV bRTR "\n");
-  printf(bH "            gasless send : %s " bH " dangerous delegatecall : %s " bH "\n", toResult(vulnerabilities[GASLESS_SEND]), toResult(vulnerabilities[DELEGATE_CALL]));
-  printf(bH "      exception disorder : %s " bH "         freezing ether : %s " bH "\n", toResult(vulnerabilities[EXCEPTION_DISORDER]), toResult(vulnerabilities[FREEZING]));
-  printf(bH "              reentrancy : %s " bH "       integer overflow : %s " bH "\n", toResult(vulnerabilities[REENTRANCY]), toResult(vulnerabilities[OVERFLOW]));
-  printf(bH "    timestamp dependency : %s " bH "      integer underflow : %s " bH "\n", toResult(vulnerabilities[TIME_DEPENDENCY]), toResult(vulnerabilities[UNDERFLOW]));
-  printf(bH " block number dependency : %s " bH "%s" bH "\n", toResult(vulnerabilities[NUMBER_DEPENDENCY]), padStr(" ", 32).c_str());
+  /* First half of the oracles goes to the left column, the rest to the right one */
+  auto rows = (vulnerabilities.size() + 1) / 2;
+  auto oracleCell = [&](size_t idx, int width) {
+    if (idx >= vulnerabilities.size()) return padStr("", width + 9);
+    auto name = oracleNames[idx].substr(0, width);
+    return string(width - name.size(), ' ') + name + " : " + toResult(vulnerabilities[idx]) + " ";
+  };
+  for (size_t row = 0; row < rows; row ++) {
+    printf(bH "%s" bH "%s" bH "\n", oracleCell(row, 24).c_str(), oracleCell(row + rows, 23).c_str());
+  }
   printf(bBL bV20 bV2 bV10 bV5 bV2 bV bBTR bV10 bV5 bV20 bV2 bV2 bBR "\n");
 }
 
@@ -139,6 +637,44 @@ void Fuzzer::writeStats(const Mutation &mutation) {
   root.put("speed", (double) fuzzStat.totalExecs / timer.elapsed());
   root.put("queueCycles", fuzzStat.queueCycle);
   root.put("uniqExceptions", uniqExceptions.size());
+  root.put("uniqHangs", uniqHangs.size());
+  root.put("slowExecs", fuzzStat.slowExecs);
+  root.put("autoDictionary", autoDict.size());
+  root.put("corpus", corpus.size());
+  root.put("trimmedBytes", fuzzStat.trimmedBytes);
+  root.put("leaderStoreBytes", store.size());
+  if (fuzzParam.stateCoverage) root.put("states", fuzzStat.states);
+  if (sync) root.put("syncFinds", fuzzStat.stageFinds[STAGE_SYNC]);
+  pt::ptree findingsNode;
+  for (auto finding : findings) {
+    pt::ptree node;
+    node.put("oracle", finding.oracle);
+    node.put("function", finding.functionIdx);
+    node.put("pc", finding.pc);
+    if (witnesses.count(finding.oracle)) node.put("witness", witnesses[finding.oracle]);
+    findingsNode.push_back(make_pair("", node));
+  }
+  root.add_child("findings", findingsNode);
+  if (fuzzParam.objective == GAS) {
+    /* Worst case of every transaction against the gas a block can hold */
+    pt::ptree gasNode;
+    for (size_t idx = 0; idx < maxGas.size(); idx ++) {
+      auto it = leaders.find("gas:" + to_string(idx));
+      if (it == leaders.end()) continue;
+      pt::ptree node;
+      node.put("function", idx < functionNames.size() ? functionNames[idx] : to_string(idx));
+      node.put("gasUsed", maxGas[idx].str());
+      node.put("blockGasLimit", blockGasLimit.str());
+      node.put("testcase", toHex(store.get(it->second.input)));
+      gasNode.push_back(make_pair("", node));
+    }
+    root.add_child("gas", gasNode);
+    root.put("loops", loopBuckets.size());
+  }
+  root.put("lastNewPath", fuzzStat.lastNewPath);
+#ifdef FUZZ_PROFILE
+  root.add_child("profile", Profiler::toJson());
+#endif
   pt::write_json(ss, root);
   stats << ss.str() << endl;
   stats.close();
@@ -146,22 +682,74 @@ void Fuzzer::writeStats(const Mutation &mutation) {
 
 /* Save data if interest */
 FuzzItem Fuzzer::saveIfInterest(TargetExecutive& te, bytes data, uint64_t depth, const tuple<unordered_set<uint64_t>, unordered_set<uint64_t>>& validJumpis) {
-  auto revisedData = ContractABI::postprocessTestData(data);
+  bytes revisedData;
+  {
+    PROFILE_SCOPE(PROF_POSTPROCESS);
+    revisedData = ContractABI::postprocessTestData(data);
+  }
   FuzzItem item(revisedData);
+  te.funcMask = execRounds ++ % FULL_EXEC_INTERVAL ? funcMask : vector<bool>();
   item.res = te.exec(revisedData, validJumpis);
   //Logger::debug(Logger::testFormat(item.data));
+  return saveItem(item, depth, isSlowInput(te, item, validJumpis));
+}
+
+/* Save a batch of data sharing one deployment per run of equal constructor and environment */
+vector<FuzzItem> Fuzzer::saveIfInterestBatch(TargetExecutive& te, const vector<bytes> &batch, uint64_t depth, const tuple<unordered_set<uint64_t>, unordered_set<uint64_t>>& validJumpis) {
+  vector<bytes> revisedBatch;
+  {
+    PROFILE_SCOPE(PROF_POSTPROCESS);
+    for (auto &data : batch) revisedBatch.push_back(ContractABI::postprocessTestData(data));
+  }
+  te.funcMask = execRounds ++ % FULL_EXEC_INTERVAL ? funcMask : vector<bool>();
+  auto results = pool
+    ? pool->execBatch(revisedBatch, te.funcMask, validJumpis)
+    : te.execBatch(revisedBatch, validJumpis);
+  if (pool) pool->mergeAutoDictionary(autoDict);
+  vector<FuzzItem> items;
+  for (size_t i = 0; i < revisedBatch.size(); i ++) {
+    FuzzItem item(revisedBatch[i]);
+    item.res = results[i];
+    /* Every input is timed on its own, one slow input of a batch is still quarantined */
+    items.push_back(saveItem(item, depth, isSlowInput(te, item, validJumpis)));
+  }
+  return items;
+}
+
+/* Update leaders with the result of an executed item */
+FuzzItem Fuzzer::saveItem(FuzzItem item, uint64_t depth, bool isSlow) {
+  PROFILE_SCOPE(PROF_BOOKKEEPING);
+  /*
+   * Slow and hanging inputs never become leaders. Their branches are not marked covered
+   * either, the next input taking them becomes their leader. Hitting the step limit is
+   * a property of the execution: only slow inputs are remembered in the quarantine
+   */
+  bool isHang = !item.res.uniqHangs.empty();
+  auto inputHash = hashBytes(item.data.data(), item.data.size());
   fuzzStat.totalExecs ++;
+  for (auto hang: item.res.uniqHangs) uniqHangs.insert(hang);
+  if (isSlow) {
+    fuzzStat.slowExecs ++;
+    Logger::debug("Quarantine slow input (" + to_string(item.res.execTime) + "s)");
+    Logger::debug(Logger::testFormat(item.data));
+  }
+  if (isSlow) quarantine.insert(inputHash);
+  if (isHang || quarantine.count(inputHash)) {
+    updateExceptions(item.res.uniqExceptions);
+    return item;
+  }
   for (auto tracebit: item.res.tracebits) {
     if (!tracebits.count(tracebit)) {
       // Remove leader
       auto lIt = find_if(leaders.begin(), leaders.end(), [=](const pair<string, Leader>& p) { return p.first == tracebit;});
-      if (lIt != leaders.end()) leaders.erase(lIt);
+      if (lIt != leaders.end()) eraseLeader(lIt->first);
       auto qIt = find_if(queues.begin(), queues.end(), [=](const string &s) { return s == tracebit; });
       if (qIt == queues.end()) queues.push_back(tracebit);
       // Insert leader
       item.depth = depth + 1;
-      auto leader = Leader(item, 0);
+      auto leader = makeLeader(item, 0);
       leaders.insert(make_pair(tracebit, leader));
+      corpusDirty = true;
       if (depth + 1 > fuzzStat.maxdepth) fuzzStat.maxdepth = depth + 1;
       fuzzStat.lastNewPath = timer.elapsed();
       Logger::debug("Cover new branch "  + tracebit);
@@ -180,17 +768,19 @@ FuzzItem Fuzzer::saveIfInterest(TargetExecutive& te, bytes data, uint64_t depth,
       Logger::debug("prev: " + lIt->second.comparisonValue.str());
       Logger::debug("now : " + predicateIt.second.str());
       // Stop debug
-      leaders.erase(lIt); // Remove leader
+      eraseLeader(predicateIt.first); // Remove leader
       item.depth = depth + 1;
-      auto leader = Leader(item, predicateIt.second);
+      auto leader = makeLeader(item, predicateIt.second);
       leaders.insert(make_pair(predicateIt.first, leader)); // Insert leader
+      corpusDirty = true;
       if (depth + 1 > fuzzStat.maxdepth) fuzzStat.maxdepth = depth + 1;
       fuzzStat.lastNewPath = timer.elapsed();
       Logger::debug(Logger::testFormat(item.data));
     } else if (lIt == leaders.end()) {
-      auto leader = Leader(item, predicateIt.second);
+      auto leader = makeLeader(item, predicateIt.second);
       item.depth = depth + 1;
       leaders.insert(make_pair(predicateIt.first, leader)); // Insert leader
+      corpusDirty = true;
       queues.push_back(predicateIt.first);
       if (depth + 1 > fuzzStat.maxdepth) fuzzStat.maxdepth = depth + 1;
       fuzzStat.lastNewPath = timer.elapsed();
@@ -200,6 +790,8 @@ FuzzItem Fuzzer::saveIfInterest(TargetExecutive& te, bytes data, uint64_t depth,
       Logger::debug(Logger::testFormat(item.data));
     }
   }
+  if (fuzzParam.objective == GAS) saveGas(item, depth);
+  if (fuzzParam.stateCoverage) saveStates(item, depth);
   updateExceptions(item.res.uniqExceptions);
   updateTracebits(item.res.tracebits);
   updatePredicates(item.res.predicates);
@@ -211,6 +803,7 @@ void Fuzzer::stop() {
   Logger::debug("== TEST ==");
   unordered_map<uint64_t, uint64_t> brs;
   for (auto it : leaders) {
+    if (!isBranch(it.first)) continue;
     auto pc = stoi(splitString(it.first, ':')[0]);
     // Covered
     if (it.second.comparisonValue == 0) {
@@ -222,9 +815,13 @@ void Fuzzer::stop() {
     }
     Logger::debug("BR " + it.first);
     Logger::debug("ComparisonValue " + it.second.comparisonValue.str());
-    Logger::debug(Logger::testFormat(it.second.item.data));
+    Logger::debug(Logger::testFormat(store.get(it.second.input)));
   }
   Logger::debug("== END TEST ==");
+  if (fuzzParam.checkpoint.size() && leaders.size()) saveCheckpoint(false);
+  if (checkpointWriting) checkpointWriter.join();
+  /* Write the entries not exported yet */
+  sync.reset();
   for (auto it : snippets) {
     if (brs.find(it.first) == brs.end()) {
       Logger::info(">> Unreachable");
@@ -244,36 +841,59 @@ void Fuzzer::stop() {
 
 /* Start fuzzing */
 void Fuzzer::start() {
-  TargetContainer container;
+  TargetContainer container(fork.get());
   Dictionary codeDict, addressDict;
   unordered_set<u64> showSet;
-  for (auto contractInfo : fuzzParam.contractInfo) {
-    auto isAttacker = contractInfo.contractName.find(fuzzParam.attackerName) != string::npos;
-    if (!contractInfo.isMain && !isAttacker) continue;
-    ContractABI ca(contractInfo.abiJson);
-    auto bin = fromHex(contractInfo.bin);
-    auto binRuntime = fromHex(contractInfo.binRuntime);
-    // Accept only valid jumpis
-    auto executive = container.loadContract(bin, ca);
+  if (fuzzParam.threads > 1) pool.reset(new ExecutorPool(fuzzParam.threads, fork.get()));
+  /* Assets are deployed once, every exec rolls back to the state they left */
+  vector<DeployedContract> deployed;
+  for (auto contractInfo : deploymentOrder()) {
     if (!contractInfo.isMain) {
-      /* Load Attacker agent contract */
-      auto data = ca.randomTestcase();
-      auto revisedData = ContractABI::postprocessTestData(data);
-      executive.deploy(revisedData, EMPTY_ONOP);
-      addressDict.fromAddress(executive.addr.asBytes());
+      addressDict.fromAddress(deployAsset(container, contractInfo, deployed).asBytes());
     } else {
+      ContractABI ca(contractInfo.abiJson);
+      auto bin = fromHex(contractInfo.bin);
+      auto binRuntime = fromHex(contractInfo.binRuntime);
+      auto executive = loadExecutive(container, contractInfo);
+      executive.wired = deployed;
+      executive.autoDict = &autoDict;
+      executive.countLoops = fuzzParam.objective == GAS;
+      executive.stateCoverage = fuzzParam.stateCoverage;
+      if (pool) pool->load(bin, ca, executive);
       auto contractName = contractInfo.contractName;
-      boost::filesystem::remove_all(contractName);
-      boost::filesystem::create_directory(contractName);
+      /* A resumed campaign keeps the witnesses of its findings */
+      if (!fuzzParam.resume) boost::filesystem::remove_all(contractName);
+      boost::filesystem::create_directories(contractName);
       codeDict.fromCode(bin);
       auto bytecodeBranch = BytecodeBranch(contractInfo);
       auto validJumpis = bytecodeBranch.findValidJumpis();
+      runtimeJumpis = get<1>(validJumpis);
       snippets = bytecodeBranch.snippets;
-      if (!(get<0>(validJumpis).size() + get<1>(validJumpis).size())) {
+      blockGasLimit = container.blockGasLimit();
+      functionNames.push_back("constructor");
+      auto reaches = BytecodeBranch::findFunctionReach(binRuntime);
+      for (auto fd : ca.fds) {
+        if (fd.name == "") continue;
+        functionNames.push_back(fd.name);
+        auto selector = ContractABI::functionSelector(fd.name, fd.tds);
+        auto it = reaches.find((uint32_t) fromBigEndian<u32>(selector));
+        funcReaches.push_back(it != reaches.end() ? it->second : FunctionReach());
+      }
+      if (!(get<0>(validJumpis).size() + get<1>(validJumpis).size()) && fuzzParam.objective == COVERAGE) {
         cout << "No valid jumpi" << endl;
         stop();
       }
-      saveIfInterest(executive, ca.randomTestcase(), 0, validJumpis);
+      if (fuzzParam.resume) {
+        bytes checkpointData;
+        if (!readCheckpoint(fuzzParam.checkpoint, checkpointData)) {
+          cout << "[x] No checkpoint " << fuzzParam.checkpoint << endl;
+          exit(CHECKPOINT_EXIT);
+        }
+        restore(checkpointData);
+      } else {
+        saveIfInterest(executive, ca.randomTestcase(), 0, validJumpis);
+      }
+      if (fuzzParam.syncDir.size()) sync.reset(new SyncDir(fuzzParam.syncDir, fuzzParam.syncId, fuzzParam.syncInterval));
       int originHitCount = leaders.size();
       // No branch
       if (!originHitCount) {
@@ -283,10 +903,11 @@ void Fuzzer::start() {
       // There are uncovered branches or not
       auto fi = [&](const pair<string, Leader> &p) { return p.second.comparisonValue != 0;};
       auto numUncoveredBranches = count_if(leaders.begin(), leaders.end(), fi);
-      if (!numUncoveredBranches) {
-        auto curItem = (*leaders.begin()).second.item;
+      if (!numUncoveredBranches && fuzzParam.objective == COVERAGE) {
+        auto curItem = leaderItem((*leaders.begin()).first);
         Mutation mutation(curItem, make_tuple(codeDict, addressDict));
-        vulnerabilities = container.analyze();
+        analyze(container);
+        saveFindings(executive, validJumpis, true);
         switch (fuzzParam.reporter) {
           case TERMINAL: {
             showStats(mutation, validJumpis);
@@ -306,8 +927,16 @@ void Fuzzer::start() {
       }
       // Jump to fuzz loop
       while (true) {
+        /* Between two leaders the queue position is exact */
+        auto isCheckpointDue = fuzzParam.checkpointInterval && timer.elapsed() - lastCheckpoint >= fuzzParam.checkpointInterval * 60;
+        if (fuzzParam.checkpoint.size() && isCheckpointDue) saveCheckpoint(true);
+        if (sync) syncLeaders(executive, validJumpis);
         auto leaderIt = leaders.find(queues[fuzzStat.idx]);
-        auto curItem = leaderIt->second.item;
+        if (isBranch(leaderIt->first) && !leaderIt->second.trimmed) {
+          trimLeader(executive, leaderIt->first, validJumpis);
+        }
+        auto curItem = leaderItem(leaderIt->first);
+        auto curInput = leaderIt->second.input;
         auto comparisonValue = leaderIt->second.comparisonValue;
         if (comparisonValue != 0) {
           Logger::debug(" == Leader ==");
@@ -317,14 +946,14 @@ void Fuzzer::start() {
           Logger::debug(Logger::testFormat(curItem.data));
         }
         Mutation mutation(curItem, make_tuple(codeDict, addressDict));
-        auto save = [&](bytes data) {
-          auto item = saveIfInterest(executive, data, curItem.depth, validJumpis);
+        auto report = [&]() {
           /* Show every one second */
           u64 duration = timer.elapsed();
           if (!showSet.count(duration)) {
             showSet.insert(duration);
             if (duration % fuzzParam.analyzingInterval == 0) {
-              vulnerabilities = container.analyze();
+              analyze(container);
+              saveFindings(executive, validJumpis, false);
             }
             switch (fuzzParam.reporter) {
               case TERMINAL: {
@@ -342,10 +971,12 @@ void Fuzzer::start() {
               }
             }
           }
-          /* Stop program */
-          u64 speed = (u64)(fuzzStat.totalExecs / timer.elapsed());
-          if (timer.elapsed() > fuzzParam.duration || speed <= 10 || !predicates.size()) {
-            vulnerabilities = container.analyze();
+          /* Stop program when time is up, all predicates are covered or coverage has plateaued */
+          auto isPlateau = fuzzParam.plateau && timer.elapsed() - fuzzStat.lastNewPath > fuzzParam.plateau;
+          auto isCovered = fuzzParam.objective == COVERAGE && !predicates.size();
+          if (timer.elapsed() > fuzzParam.duration || isPlateau || isCovered) {
+            analyze(container);
+            saveFindings(executive, validJumpis, true);
             switch(fuzzParam.reporter) {
               case TERMINAL: {
                 showStats(mutation, validJumpis);
@@ -363,12 +994,45 @@ void Fuzzer::start() {
             }
             stop();
           }
+        };
+        auto save = [&](bytes data) {
+          auto item = saveIfInterest(executive, data, curItem.depth, validJumpis);
+          report();
           return item;
         };
-        // If it is uncovered branch
-        if (comparisonValue != 0) {
+        auto saveBatch = [&](const vector<bytes> &batch) {
+          auto items = saveIfInterestBatch(executive, batch, curItem.depth, validJumpis);
+          report();
+          return items;
+        };
+        /* Every executor of the pool gets batchSize candidates */
+        mutation.setBatch(saveBatch, fuzzParam.batchSize * (pool ? pool->size() : 1));
+        // If it is uncovered branch or leads gas, a loop or a storage state
+        auto isFeedbackLeader = !isBranch(leaderIt->first);
+        if (comparisonValue != 0 || isFeedbackLeader) {
           // Haven't fuzzed before
-          if (!curItem.fuzzedCount) {
+          if (!curItem.fuzzedCount && !isFeedbackLeader && fuzzParam.syncMain) {
+            auto branch = leaderIt->first;
+            auto influence = leaderIt->second.influence;
+            if (!leaderIt->second.influenceInferred) {
+              Logger::debug("Influence");
+              influence = mutation.inferInfluence(branch, save);
+              fuzzStat.stageFinds[STAGE_INFLUENCE] += leaders.size() - originHitCount;
+              originHitCount = leaders.size();
+              /* Cache it on the leader unless the leader was replaced meanwhile */
+              auto lIt = leaders.find(branch);
+              if (lIt != leaders.end() && lIt->second.input == curInput) {
+                lIt->second.influence = influence;
+                lIt->second.influenceInferred = true;
+              }
+            }
+            mutation.setFocus(influence);
+
+            Logger::debug("Solve");
+            mutation.solve(branch, save);
+            fuzzStat.stageFinds[STAGE_SOLVE] += leaders.size() - originHitCount;
+            originHitCount = leaders.size();
+
             Logger::debug("SingleWalkingBit");
             mutation.singleWalkingBit(save);
             fuzzStat.stageFinds[STAGE_FLIP1] += leaders.size() - originHitCount;
@@ -429,10 +1093,10 @@ void Fuzzer::start() {
             //fuzzStat.stageFinds[STAGE_INTEREST32] += leaders.size() - originHitCount;
             //originHitCount = leaders.size();
 
-            //Logger::debug("overwriteDict");
-            //mutation.overwriteWithDictionary(save);
-            //fuzzStat.stageFinds[STAGE_EXTRAS_UO] += leaders.size() - originHitCount;
-            //originHitCount = leaders.size();
+            Logger::debug("overwriteAutoDict");
+            mutation.overwriteWithAutoDictionary(autoDict.top(branch, AUTO_DICT_TOP), save);
+            fuzzStat.stageFinds[STAGE_EXTRAS_UO] += leaders.size() - originHitCount;
+            originHitCount = leaders.size();
 
             Logger::debug("overwriteAddress");
             mutation.overwriteWithAddressDictionary(save);
@@ -449,9 +1113,8 @@ void Fuzzer::start() {
             fuzzStat.stageFinds[STAGE_HAVOC] += leaders.size() - originHitCount;
             originHitCount = leaders.size();
             Logger::debug("Splice");
-            vector<FuzzItem> items = {};
-            for (auto it : leaders) items.push_back(it.second.item);
-            if (mutation.splice(items)) {
+            updateCorpus();
+            if (mutation.splice(corpus.size(), [&](size_t idx) { return leaderItem(corpus[idx]); })) {
               Logger::debug("havoc");
               mutation.havoc(save);
               fuzzStat.stageFinds[STAGE_HAVOC] += leaders.size() - originHitCount;
@@ -459,10 +1122,56 @@ void Fuzzer::start() {
             }
           }
         }
-        leaderIt->second.item.fuzzedCount += 1;
+        /* Leader may have been replaced while fuzzing it */
+        leaderIt = leaders.find(queues[fuzzStat.idx]);
+        if (leaderIt != leaders.end() && leaderIt->second.input == curInput) {
+          leaderIt->second.fuzzedCount += 1;
+        }
         fuzzStat.idx = (fuzzStat.idx + 1) % leaders.size();
         if (fuzzStat.idx == 0) fuzzStat.queueCycle ++;
       }
     }
   }
 }
+
+/* Execute the witnesses of a findings folder again, returns the number whose oracle no longer fires */
+int Fuzzer::replay(string folder) {
+  TargetContainer container(fork.get());
+  if (fuzzParam.threads > 1) pool.reset(new ExecutorPool(fuzzParam.threads, fork.get()));
+  unique_ptr<TargetExecutive> main;
+  tuple<unordered_set<uint64_t>, unordered_set<uint64_t>> validJumpis;
+  vector<DeployedContract> deployed;
+  for (auto contractInfo : deploymentOrder()) {
+    if (!contractInfo.isMain) {
+      deployAsset(container, contractInfo, deployed);
+    } else {
+      auto executive = loadExecutive(container, contractInfo);
+      executive.wired = deployed;
+      if (pool) pool->load(fromHex(contractInfo.bin), ContractABI(contractInfo.abiJson), executive);
+      validJumpis = BytecodeBranch(contractInfo).findValidJumpis();
+      main.reset(new TargetExecutive(executive));
+    }
+  }
+  vector<string> files;
+  vector<string> oracles;
+  vector<bytes> batch;
+  for (auto &entry : boost::filesystem::directory_iterator(folder)) {
+    if (entry.path().extension() != ".json") continue;
+    pt::ptree root;
+    pt::read_json(entry.path().string(), root);
+    files.push_back(entry.path().string());
+    oracles.push_back(root.get<string>("oracle"));
+    batch.push_back(fromHex(root.get<string>("minimized", root.get<string>("testcase"))));
+  }
+  if (!main || batch.empty()) return 0;
+  auto results = pool
+    ? pool->execBatch(batch, vector<bool>(), validJumpis)
+    : main->execBatch(batch, validJumpis);
+  int missing = 0;
+  for (size_t i = 0; i < batch.size(); i ++) {
+    auto reproduced = results[i].oracleHits.count(oracles[i]) > 0;
+    if (!reproduced) missing ++;
+    cout << (reproduced ? "reproduced " : "missing    ") << oracles[i] << " : " << files[i] << endl;
+  }
+  return missing;
+}
@@ -1,11 +1,17 @@
 #pragma once
 #include <iostream>
 #include <vector>
-#include <liboracle/Common.h>
+#include <atomic>
+#include <thread>
+#include <liboracle/Oracle.h>
 #include "ContractABI.h"
 #include "Util.h"
 #include "FuzzItem.h"
 #include "Mutation.h"
+#include "TargetContainer.h"
+#include "ExecutorPool.h"
+#include "InputStore.h"
+#include "SyncDir.h"
 
 using namespace dev;
 using namespace eth;
@@ -14,6 +20,8 @@ using namespace std;
 namespace fuzzer {
   enum FuzzMode { AFL };
   enum Reporter { TERMINAL, JSON, BOTH };
+  /* What makes a test case a leader: new branches, or also more gas used */
+  enum Objective { COVERAGE, GAS };
   struct ContractInfo {
     string abiJson;
     string bin;
@@ -31,7 +39,40 @@ namespace fuzzer {
     Reporter reporter;
     int duration;
     int analyzingInterval;
+    /* Stop when no new path is found for plateau seconds, 0 disables it */
+    int plateau = 0;
+    /* Gas shared by all transactions of a test case */
+    uint64_t gasBudget = 0;
+    /* Steps of a single transaction, 0 means unlimited */
+    uint64_t stepLimit = 0;
+    /* File backing the leader test cases, empty keeps them in memory */
+    string leaderStore;
+    /* Candidates a mutation stage executes together */
+    size_t batchSize = 1;
+    /* Executors running batches in parallel, 1 runs them on the fuzzing thread */
+    size_t threads = 1;
+    Objective objective = COVERAGE;
     string attackerName;
+    /* What the attacker contract sends when it calls out */
+    AttackerStrategy attackerStrategy = AttackerStrategy::Reenter;
+    /* Keep inputs reaching new storage states, not only new branches */
+    bool stateCoverage = false;
+    /* Chain database and state root to fork, empty starts from an empty state */
+    string forkDb;
+    string forkRoot;
+    /* File of the campaign checkpoint, empty disables it */
+    string checkpoint;
+    /* Minutes between background checkpoints, 0 only writes one when fuzzing stops */
+    int checkpointInterval = 0;
+    /* Continue the campaign of the checkpoint file instead of starting over */
+    bool resume = false;
+    /* Directory shared with peer instances, empty disables syncing */
+    string syncDir;
+    string syncId;
+    /* Secondary instances skip the deterministic stages, as AFL -S does */
+    bool syncMain = true;
+    /* Seconds between two sync rounds */
+    int syncInterval = 30;
   };
   struct FuzzStat {
     int idx = 0;
@@ -41,35 +82,117 @@ namespace fuzzer {
     int queueCycle = 0;
     int stageFinds[32];
     double lastNewPath = 0;
+    double avgExecTime = 0;
+    int slowExecs = 0;
+    uint64_t trimmedBytes = 0;
+    uint64_t states = 0;
   };
+  /* Leaders keep their test case in the store and only scalars of its result */
   struct Leader {
-    FuzzItem item;
+    InputRef input;
+    uint64_t cksum = 0;
+    /* Ids of the covered branches, for corpus minimization */
+    vector<uint32_t> branches;
+    uint64_t fuzzedCount = 0;
+    uint64_t depth = 0;
     u256 comparisonValue = 0;
-    Leader(FuzzItem _item, u256 _comparisionValue): item(_item) {
+    /* Input bytes which move the comparison of the branch, empty means all */
+    bytes influence;
+    bool influenceInferred = false;
+    /* Trimmed once, a new test case of the branch is a new leader */
+    bool trimmed = false;
+    Leader(InputRef _input, const FuzzItem &item, u256 _comparisionValue): input(_input) {
+      cksum = item.res.cksum;
+      fuzzedCount = item.fuzzedCount;
+      depth = item.depth;
       comparisonValue = _comparisionValue;
     }
   };
   class Fuzzer {
     vector<bool> vulnerabilities;
+    vector<string> oracleNames;
+    vector<OracleFinding> findings;
+    /* Witness file of every oracle which fired */
+    unordered_map<string, string> witnesses;
+    /* Oracles whose witness is minimized already */
+    unordered_set<string> minimizedWitnesses;
     vector<string> queues;
     unordered_set<string> tracebits;
     unordered_set<string> predicates;
     unordered_map<string, Leader> leaders;
     unordered_map<uint64_t, string> snippets;
     unordered_set<string> uniqExceptions;
+    unordered_set<string> uniqHangs;
+    /* Hashes of the inputs which are never made leaders */
+    unordered_set<uint64_t> quarantine;
+    InputStore store;
+    AutoDictionary autoDict;
+    /* Static reach of the main contract functions in encodeFunctions order */
+    vector<FunctionReach> funcReaches;
+    /* Jumpis of the runtime code, funcReaches are in its pc space */
+    unordered_set<uint64_t> runtimeJumpis;
+    vector<bool> funcMask;
+    uint64_t execRounds = 0;
+    unique_ptr<ExecutorPool> pool;
+    unique_ptr<ForkSource> fork;
+    /* Leaders covering every covered branch, used for splicing */
+    vector<string> corpus;
+    bool corpusDirty = true;
+    unordered_map<string, uint32_t> branchIds;
+    /* Most gas used by every transaction and log2 of the most iterations of every loop */
+    vector<u256> maxGas;
+    unordered_map<uint64_t, int> loopBuckets;
+    vector<string> functionNames;
+    u256 blockGasLimit = 0;
+    void saveGas(FuzzItem &item, uint64_t depth);
+    /* Storage states reached so far, STATE_MAP_SIZE entries once used */
+    vector<bool> stateMap;
+    void saveStates(FuzzItem &item, uint64_t depth);
+    void promoteLeader(const string &key, FuzzItem &item, uint64_t depth);
+    uint32_t branchId(const string &branch);
+    Leader makeLeader(const FuzzItem &item, u256 comparisonValue);
+    void eraseLeader(const string &key);
+    /* Test case of a leader with the cksum and predicate the mutation stages read */
+    FuzzItem leaderItem(const string &branch);
+    void updateCorpus();
+    void trimLeader(TargetExecutive &te, const string &branch, const tuple<unordered_set<uint64_t>, unordered_set<uint64_t>> &validJumpis);
+    void updateFuncMask();
+    /* Writer of the last background checkpoint, joined before the next one starts */
+    thread checkpointWriter;
+    bool checkpointWriting = false;
+    atomic<bool> checkpointDone{false};
+    double lastCheckpoint = 0;
+    bytes checkpoint();
+    void restore(const bytes &data);
+    void saveCheckpoint(bool background);
+    unique_ptr<SyncDir> sync;
+    /* Branches whose leader was published to the peers */
+    unordered_set<string> synced;
+    void syncLeaders(TargetExecutive &te, const tuple<unordered_set<uint64_t>, unordered_set<uint64_t>> &validJumpis);
     Timer timer;
     FuzzParam fuzzParam;
     FuzzStat fuzzStat;
     void writeStats(const Mutation &mutation);
+    void analyze(TargetContainer &container);
+    void saveFindings(TargetExecutive &te, const tuple<unordered_set<uint64_t>, unordered_set<uint64_t>> &validJumpis, bool minimize);
+    bool isSlowExec(double execTime);
+    bool isOutlier(double execTime) const;
+    bool isSlowInput(TargetExecutive &te, const FuzzItem &item, const tuple<unordered_set<uint64_t>, unordered_set<uint64_t>> &validJumpis);
     ContractInfo mainContract();
+    vector<ContractInfo> deploymentOrder();
+    TargetExecutive loadExecutive(TargetContainer &container, const ContractInfo &contractInfo);
+    Address deployAsset(TargetContainer &container, const ContractInfo &contractInfo, vector<DeployedContract> &deployed);
+    FuzzItem saveItem(FuzzItem item, uint64_t depth, bool isSlow);
     public:
       Fuzzer(FuzzParam fuzzParam);
       FuzzItem saveIfInterest(TargetExecutive& te, bytes data, uint64_t depth, const tuple<unordered_set<uint64_t>, unordered_set<uint64_t>> &validJumpis);
+      vector<FuzzItem> saveIfInterestBatch(TargetExecutive& te, const vector<bytes> &batch, uint64_t depth, const tuple<unordered_set<uint64_t>, unordered_set<uint64_t>> &validJumpis);
       void showStats(const Mutation &mutation, const tuple<unordered_set<uint64_t>, unordered_set<uint64_t>> &validJumpis);
       void updateTracebits(unordered_set<string> tracebits);
       void updatePredicates(unordered_map<string, u256> predicates);
       void updateExceptions(unordered_set<string> uniqExceptions);
       void start();
+      int replay(string folder);
       void stop();
   };
 }
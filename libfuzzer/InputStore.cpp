@@ -0,0 +1,129 @@
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "InputStore.h"
+
+namespace fuzzer {
+  /* The file is unlinked right away, nobody else sees it and it goes away with the process */
+  void InputStore::open(string folder) {
+    auto path = folder + "/leaders.XXXXXX";
+    fd = mkstemp(&path[0]);
+    if (fd < 0) {
+      cout << "> Can not create leader store in " << folder << endl;
+      exit(0);
+    }
+    unlink(path.c_str());
+  }
+
+  InputStore::~InputStore() {
+    if (mapped) munmap(mapped, capacity);
+    if (fd >= 0) close(fd);
+  }
+
+  void InputStore::reserve(uint64_t size) {
+    if (size <= capacity) return;
+    auto newCapacity = max(size, max(capacity * 2, (uint64_t) 1 << 16));
+    if (fd < 0) {
+      memory.resize(newCapacity);
+    } else {
+      if (mapped) munmap(mapped, capacity);
+      if (ftruncate(fd, newCapacity)) {
+        cout << "> Can not grow leader store" << endl;
+        exit(0);
+      }
+      mapped = (byte *) mmap(nullptr, newCapacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      if (mapped == MAP_FAILED) {
+        cout << "> Can not map leader store" << endl;
+        exit(0);
+      }
+    }
+    capacity = newCapacity;
+  }
+
+  void InputStore::removeFree(map<uint64_t, uint64_t>::iterator it) {
+    auto range = freeSizes.equal_range(it->second);
+    for (auto sIt = range.first; sIt != range.second; ++sIt) {
+      if (sIt->second == it->first) {
+        freeSizes.erase(sIt);
+        break;
+      }
+    }
+    freeOffsets.erase(it);
+  }
+
+  /* Best fit from the free list, the end of the arena otherwise */
+  uint64_t InputStore::allocate(uint64_t size) {
+    auto sIt = freeSizes.lower_bound(size);
+    if (sIt == freeSizes.end()) {
+      reserve(used + size);
+      used += size;
+      return used - size;
+    }
+    auto offset = sIt->second;
+    auto rangeSize = sIt->first;
+    removeFree(freeOffsets.find(offset));
+    if (rangeSize > size) {
+      freeOffsets[offset + size] = rangeSize - size;
+      freeSizes.insert(make_pair(rangeSize - size, offset + size));
+    }
+    return offset;
+  }
+
+  void InputStore::freeRange(uint64_t offset, uint64_t size) {
+    auto next = freeOffsets.find(offset + size);
+    if (next != freeOffsets.end()) {
+      size += next->second;
+      removeFree(next);
+    }
+    auto prev = freeOffsets.lower_bound(offset);
+    if (prev != freeOffsets.begin() && (--prev)->first + prev->second == offset) {
+      offset = prev->first;
+      size += prev->second;
+      removeFree(prev);
+    }
+    /* A range at the end gives the arena back */
+    if (offset + size == used) {
+      used = offset;
+      return;
+    }
+    freeOffsets[offset] = size;
+    freeSizes.insert(make_pair(size, offset));
+  }
+
+  InputRef InputStore::add(const bytes &data) {
+    auto hash = hashBytes(data.data(), data.size());
+    auto &slots = index[hash];
+    for (auto &slot : slots) {
+      auto ref = slot.ref;
+      if (ref.size == data.size() && equal(data.begin(), data.end(), base() + ref.offset)) {
+        slot.refs ++;
+        return ref;
+      }
+    }
+    Slot slot;
+    slot.ref.size = data.size();
+    slot.ref.offset = data.size() ? allocate(data.size()) : 0;
+    slot.refs = 1;
+    copy(data.begin(), data.end(), base() + slot.ref.offset);
+    live += data.size();
+    slots.push_back(slot);
+    return slot.ref;
+  }
+
+  void InputStore::release(InputRef ref) {
+    auto hash = hashBytes(base() + ref.offset, ref.size);
+    auto it = index.find(hash);
+    if (it == index.end()) return;
+    auto &slots = it->second;
+    auto sIt = find_if(slots.begin(), slots.end(), [&](const Slot &slot) { return slot.ref == ref; });
+    if (sIt == slots.end() || -- sIt->refs) return;
+    slots.erase(sIt);
+    if (slots.empty()) index.erase(it);
+    live -= ref.size;
+    if (ref.size) freeRange(ref.offset, ref.size);
+  }
+
+  bytes InputStore::get(InputRef ref) const {
+    return bytes(base() + ref.offset, base() + ref.offset + ref.size);
+  }
+}
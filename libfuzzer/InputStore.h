@@ -0,0 +1,57 @@
+#pragma once
+#include <vector>
+#include <map>
+#include "Common.h"
+#include "Util.h"
+
+using namespace dev;
+using namespace std;
+
+namespace fuzzer {
+  struct InputRef {
+    uint64_t offset = 0;
+    uint64_t size = 0;
+    bool operator==(const InputRef &other) const { return offset == other.offset && size == other.size; }
+    bool operator!=(const InputRef &other) const { return !(*this == other); }
+  };
+  /*
+   * Arena of test cases, equal inputs are stored once and counted. The space of an
+   * input nobody refers to any more goes to a free list which later inputs reuse.
+   * With a directory the arena is a private file in it mapped into memory and
+   * leaders keep no input on the heap
+   */
+  class InputStore {
+      struct Slot {
+        InputRef ref;
+        uint64_t refs = 0;
+      };
+      bytes memory;
+      int fd = -1;
+      byte *mapped = nullptr;
+      uint64_t capacity = 0;
+      uint64_t used = 0;
+      uint64_t live = 0;
+      unordered_map<uint64_t, vector<Slot>> index;
+      /* Free ranges by offset and by size, neighbours are merged */
+      map<uint64_t, uint64_t> freeOffsets;
+      multimap<uint64_t, uint64_t> freeSizes;
+      byte *base() const { return fd < 0 ? (byte *) memory.data() : mapped; }
+      void reserve(uint64_t size);
+      uint64_t allocate(uint64_t size);
+      void freeRange(uint64_t offset, uint64_t size);
+      void removeFree(map<uint64_t, uint64_t>::iterator it);
+    public:
+      InputStore() {}
+      InputStore(const InputStore&) = delete;
+      InputStore& operator=(const InputStore&) = delete;
+      ~InputStore();
+      /* Back the arena by a file in the directory, only before the first add */
+      void open(string folder);
+      /* Every add takes a reference which release gives back */
+      InputRef add(const bytes &data);
+      void release(InputRef ref);
+      bytes get(InputRef ref) const;
+      /* Bytes of the inputs still referred to */
+      uint64_t size() const { return live; }
+  };
+}
@@ -0,0 +1,77 @@
+#include "Minimizer.h"
+
+namespace fuzzer {
+  bytes Minimizer::minimize(bytes data, KeepFunc keep) {
+    auto tryZero = [&](uint64_t pos, uint64_t len) {
+      bytes origin(data.begin() + pos, data.begin() + pos + len);
+      if (all_of(origin.begin(), origin.end(), [](byte b) { return !b; })) return true;
+      if (execs >= maxExecs) return false;
+      fill(data.begin() + pos, data.begin() + pos + len, 0);
+      execs ++;
+      if (keep(data)) return true;
+      copy(origin.begin(), origin.end(), data.begin() + pos);
+      return false;
+    };
+    vector<uint64_t> kept;
+    for (uint64_t pos = 0; pos + 32 <= data.size(); pos += 32) {
+      if (!tryZero(pos, 32)) kept.push_back(pos);
+    }
+    for (auto word : kept) {
+      for (uint64_t pos = word; pos < word + 32; pos ++) tryZero(pos, 1);
+    }
+    return data;
+  }
+
+  bool Minimizer::tryData(bytes &data, const bytes &candidate, KeepFunc keep) {
+    if (candidate == data || execs >= maxExecs) return false;
+    execs ++;
+    if (!keep(candidate)) return false;
+    data = candidate;
+    return true;
+  }
+
+  /*
+   * The first word holds one length per dynamic value, the values follow the
+   * sender and block words. Shorter lengths need fewer words at the tail
+   */
+  bytes Minimizer::trim(bytes data, KeepFunc keep) {
+    for (uint64_t pos = 0; pos < 32 && pos < data.size(); pos ++) {
+      for (auto len = data[pos]; len; len /= 2) {
+        auto candidate = data;
+        candidate[pos] = len / 2;
+        if (!tryData(data, candidate, keep)) break;
+      }
+    }
+    for (uint64_t words = data.size() > 96 ? (data.size() - 96) / 64 : 0; words; words /= 2) {
+      while (data.size() >= 96 + words * 32) {
+        auto candidate = bytes(data.begin(), data.end() - words * 32);
+        if (!tryData(data, candidate, keep)) break;
+      }
+    }
+    return minimize(data, keep);
+  }
+
+  vector<size_t> Minimizer::cover(const vector<vector<uint32_t>> &sets) {
+    unordered_set<uint32_t> uncovered;
+    for (auto &s : sets) uncovered.insert(s.begin(), s.end());
+    vector<size_t> chosen;
+    vector<bool> used(sets.size(), false);
+    while (uncovered.size()) {
+      size_t best = 0;
+      size_t bestGain = 0;
+      for (size_t i = 0; i < sets.size(); i ++) {
+        if (used[i]) continue;
+        auto gain = count_if(sets[i].begin(), sets[i].end(), [&](uint32_t id) { return uncovered.count(id); });
+        if ((size_t) gain > bestGain) {
+          best = i;
+          bestGain = gain;
+        }
+      }
+      if (!bestGain) break;
+      used[best] = true;
+      chosen.push_back(best);
+      for (auto id : sets[best]) uncovered.erase(id);
+    }
+    return chosen;
+  }
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <vector>
+#include "Common.h"
+#include "Util.h"
+
+using namespace dev;
+using namespace eth;
+using namespace std;
+
+namespace fuzzer {
+  using KeepFunc = function<bool (const bytes &data)>;
+  /*
+   * Shrink a test case while keep still holds. Whole 32 bytes words are zeroed
+   * first, then the single bytes of the words which had to stay
+   */
+  class Minimizer {
+      uint64_t maxExecs;
+      bool tryData(bytes &data, const bytes &candidate, KeepFunc keep);
+    public:
+      uint64_t execs = 0;
+      Minimizer(uint64_t maxExecs = MINIMIZE_MAX_EXECS): maxExecs(maxExecs) {}
+      bytes minimize(bytes data, KeepFunc keep);
+      /* Shorten dynamic lengths and trailing words, then zero what is left over */
+      bytes trim(bytes data, KeepFunc keep);
+      /* Greedy set cover, indices of the sets which together cover every branch id */
+      static vector<size_t> cover(const vector<vector<uint32_t>> &sets);
+  };
+}
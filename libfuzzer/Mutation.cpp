@@ -21,6 +21,27 @@ Mutation::Mutation(FuzzItem item, Dicts dicts): curFuzzItem(item), dicts(dicts),
   stageName = "init";
 }
 
+/* Execute candidates batchSize at a time when a batch callback is set */
+void Mutation::setBatch(OnMutateBatchFunc _batchCb, size_t _batchSize) {
+  batchCb = _batchCb;
+  batchSize = _batchSize;
+}
+
+void Mutation::emit(OnMutateFunc cb, const bytes &data) {
+  if (!batchCb || batchSize <= 1) {
+    cb(data);
+    return;
+  }
+  pending.push_back(data);
+  if (pending.size() >= batchSize) flush();
+}
+
+void Mutation::flush() {
+  if (pending.empty()) return;
+  batchCb(pending);
+  pending.clear();
+}
+
 void Mutation::flipbit(int pos) {
   curFuzzItem.data[pos >> 3] ^= (128 >> (pos & 7));
 }
@@ -28,52 +49,75 @@ void Mutation::flipbit(int pos) {
 void Mutation::singleWalkingBit(OnMutateFunc cb) {
   stageName = "bitflip 1/1";
   stageMax = dataSize << 3;
+  uint64_t skipped = 0;
   /* Start fuzzing */
   for (stageCur = 0; stageCur < stageMax ; stageCur += 1) {
+    if (!isFocused(stageCur >> 3)) {
+      skipped ++;
+      continue;
+    }
     flipbit(stageCur);
-    cb(curFuzzItem.data);
+    emit(cb, curFuzzItem.data);
     flipbit(stageCur);
   }
-  stageCycles[STAGE_FLIP1] += stageMax;
+  flush();
+  stageCycles[STAGE_FLIP1] += stageMax - skipped;
 }
 
 void Mutation::twoWalkingBit(OnMutateFunc cb) {
   stageName = "bitflip 2/1";
   stageMax = (dataSize << 3) - 1;
+  uint64_t skipped = 0;
   /* Start fuzzing */
   for (stageCur = 0; stageCur < stageMax; stageCur += 1) {
+    if (!isFocused(stageCur >> 3) && !isFocused((stageCur + 1) >> 3)) {
+      skipped ++;
+      continue;
+    }
     flipbit(stageCur);
     flipbit(stageCur + 1);
-    cb(curFuzzItem.data);
+    emit(cb, curFuzzItem.data);
     flipbit(stageCur);
     flipbit(stageCur + 1);
   }
-  stageCycles[STAGE_FLIP2] += stageMax;
+  flush();
+  stageCycles[STAGE_FLIP2] += stageMax - skipped;
 }
 
 void Mutation::fourWalkingBit(OnMutateFunc cb) {
   stageName = "bitflip 4/1";
   stageMax = (dataSize << 3) - 3;
+  uint64_t skipped = 0;
   /* Start fuzzing */
   for (stageCur = 0; stageCur < stageMax; stageCur += 1) {
+    if (!isFocused(stageCur >> 3) && !isFocused((stageCur + 3) >> 3)) {
+      skipped ++;
+      continue;
+    }
     flipbit(stageCur);
     flipbit(stageCur + 1);
     flipbit(stageCur + 2);
     flipbit(stageCur + 3);
-    cb(curFuzzItem.data);
+    emit(cb, curFuzzItem.data);
     flipbit(stageCur);
     flipbit(stageCur + 1);
     flipbit(stageCur + 2);
     flipbit(stageCur + 3);
   }
-  stageCycles[STAGE_FLIP4] += stageMax;
+  flush();
+  stageCycles[STAGE_FLIP4] += stageMax - skipped;
 }
 
 void Mutation::singleWalkingByte(OnMutateFunc cb) {
   stageName = "bitflip 8/8";
   stageMax = dataSize;
+  uint64_t skipped = 0;
   /* Start fuzzing */
   for (stageCur = 0; stageCur < stageMax; stageCur += 1) {
+    if (!isFocused(stageCur)) {
+      skipped ++;
+      continue;
+    }
     curFuzzItem.data[stageCur] ^= 0xFF;
     FuzzItem item = cb(curFuzzItem.data);
     /* We also use this stage to pull off a simple trick: we identify
@@ -90,11 +134,11 @@ void Mutation::singleWalkingByte(OnMutateFunc cb) {
   }
   /* If the effector map is more than EFF_MAX_PERC dense, just flag the
    whole thing as worth fuzzing, since we wouldn't be saving much time
-   anyway. */
-  if (effCount != effALen(dataSize) && effCount * 100 / effALen(dataSize) > EFF_MAX_PERC) {
+   anyway. A focused effector map stays as narrow as the focus. */
+  if (focus.empty() && effCount != effALen(dataSize) && effCount * 100 / effALen(dataSize) > EFF_MAX_PERC) {
     eff = bytes(effALen(dataSize), 1);
   }
-  stageCycles[STAGE_FLIP8] += stageMax;
+  stageCycles[STAGE_FLIP8] += stageMax - skipped;
 }
 
 void Mutation::twoWalkingByte(OnMutateFunc cb) {
@@ -110,10 +154,11 @@ void Mutation::twoWalkingByte(OnMutateFunc cb) {
       continue;
     }
     *(u16*)(buf + i) ^= 0xFFFF;
-    cb(curFuzzItem.data);
+    emit(cb, curFuzzItem.data);
     stageCur ++;
     *(u16*)(buf + i) ^= 0xFFFF;
   }
+  flush();
   stageCycles[STAGE_FLIP16] += stageMax;
 }
 
@@ -131,10 +176,11 @@ void Mutation::fourWalkingByte(OnMutateFunc cb) {
       continue;
     }
     *(u32*)(buf + i) ^= 0xFFFFFFFF;
-    cb(curFuzzItem.data);
+    emit(cb, curFuzzItem.data);
     stageCur ++;
     *(u32*)(buf + i) ^= 0xFFFFFFFF;
   }
+  flush();
   stageCycles[STAGE_FLIP32] += stageMax;
 }
 
@@ -154,18 +200,19 @@ void Mutation::singleArith(OnMutateFunc cb) {
       byte r = orig ^ (orig + j);
       if (!couldBeBitflip(r)) {
         curFuzzItem.data[i] = orig + j;
-        cb(curFuzzItem.data);
+        emit(cb, curFuzzItem.data);
         stageCur ++;
       } else stageMax --;
       r = orig ^ (orig - j);
       if (!couldBeBitflip(r)) {
         curFuzzItem.data[i] = orig - j;
-        cb(curFuzzItem.data);
+        emit(cb, curFuzzItem.data);
         stageCur ++;
       } else stageMax --;
       curFuzzItem.data[i] = orig;
     }
   }
+  flush();
   stageCycles[STAGE_ARITH8] += stageMax;
 }
 
@@ -188,27 +235,28 @@ void Mutation::twoArith(OnMutateFunc cb) {
       u16 r4 = orig ^ swap16(swap16(orig) - j);
       if ((orig & 0xFF) + j > 0xFF && !couldBeBitflip(r1)) {
         *(u16*)(buf + i) = orig + j;
-        cb(curFuzzItem.data);
+        emit(cb, curFuzzItem.data);
         stageCur ++;
       } else stageMax --;
       if ((orig & 0xFF) < j && !couldBeBitflip(r2)) {
         *(u16*)(buf + i) = orig - j;
-        cb(curFuzzItem.data);
+        emit(cb, curFuzzItem.data);
         stageCur ++;
       } else stageMax --;
       if ((orig >> 8) + j > 0xFF && !couldBeBitflip(r3)) {
         *(u16*)(buf + i) = swap16(swap16(orig) + j);
-        cb(curFuzzItem.data);
+        emit(cb, curFuzzItem.data);
         stageCur ++;
       } else stageMax --;
       if ((orig >> 8) < j && !couldBeBitflip(r4)) {
         *(u16*)(buf + i) = swap16(swap16(orig) - j);
-        cb(curFuzzItem.data);
+        emit(cb, curFuzzItem.data);
         stageCur ++;
       } else stageMax --;
       *(u16*)(buf + i) = orig;
     }
   }
+  flush();
   stageCycles[STAGE_ARITH16] += stageMax;
 }
 
@@ -232,27 +280,28 @@ void Mutation::fourArith(OnMutateFunc cb) {
       u32 r4 = orig ^ swap32(swap32(orig) - j);
       if ((orig & 0xFFFF) + j > 0xFFFF && !couldBeBitflip(r1)) {
         *(u32*)(buf + i) = orig + j;
-        cb(curFuzzItem.data);
+        emit(cb, curFuzzItem.data);
         stageCur ++;
       } else stageMax --;
       if ((orig & 0xFFFF) < (u32)j && !couldBeBitflip(r2)) {
         *(u32*)(buf + i) = orig - j;
-        cb(curFuzzItem.data);
+        emit(cb, curFuzzItem.data);
         stageCur ++;
       } else stageMax --;
       if ((swap32(orig) & 0xFFFF) + j > 0xFFFF && !couldBeBitflip(r3)) {
         *(u32*)(buf + i) = swap32(swap32(orig) + j);
-        cb(curFuzzItem.data);
+        emit(cb, curFuzzItem.data);
         stageCur ++;
       } else stageMax --;
       if ((swap32(orig) & 0xFFFF) < (u32) j && !couldBeBitflip(r4)) {
         *(u32*)(buf + i) = swap32(swap32(orig) - j);
-        cb(curFuzzItem.data);
+        emit(cb, curFuzzItem.data);
         stageCur ++;
       } else stageMax --;
       *(u32*)(buf + i) = orig;
     }
   }
+  flush();
   stageCycles[STAGE_ARITH32] += stageMax;
 }
 
@@ -274,11 +323,12 @@ void Mutation::singleInterest(OnMutateFunc cb) {
         continue;
       }
       curFuzzItem.data[i] = INTERESTING_8[j];
-      cb(curFuzzItem.data);
+      emit(cb, curFuzzItem.data);
       stageCur ++;
       curFuzzItem.data[i] = orig;
     }
   }
+  flush();
   stageCycles[STAGE_INTEREST8] += stageMax;
 }
 
@@ -299,7 +349,7 @@ void Mutation::twoInterest(OnMutateFunc cb) {
           !couldBeArith(orig, (u16)INTERESTING_16[j], 2) &&
           !couldBeInterest(orig, (u16)INTERESTING_16[j], 2, 0)) {
         *(u16*)(out_buf + i) = INTERESTING_16[j];
-        cb(curFuzzItem.data);
+        emit(cb, curFuzzItem.data);
         stageCur ++;
       } else stageMax --;
 
@@ -308,12 +358,13 @@ void Mutation::twoInterest(OnMutateFunc cb) {
           !couldBeArith(orig, swap16(INTERESTING_16[j]), 2) &&
           !couldBeInterest(orig, swap16(INTERESTING_16[j]), 2, 1)) {
         *(u16*)(out_buf + i) = swap16(INTERESTING_16[j]);
-        cb(curFuzzItem.data);
+        emit(cb, curFuzzItem.data);
         stageCur ++;
       } else stageMax --;
     }
     *(u16*)(out_buf + i) = orig;
   }
+  flush();
   stageCycles[STAGE_INTEREST16] += stageMax;
 }
 
@@ -338,7 +389,7 @@ void Mutation::fourInterest(OnMutateFunc cb) {
           !couldBeArith(orig, INTERESTING_32[j], 4) &&
           !couldBeInterest(orig, INTERESTING_32[j], 4, 0)) {
         *(u32*)(out_buf + i) = INTERESTING_32[j];
-        cb(curFuzzItem.data);
+        emit(cb, curFuzzItem.data);
         stageCur ++;
       } else stageMax --;
       if ((u32)INTERESTING_32[j] != swap32(INTERESTING_32[j]) &&
@@ -346,12 +397,13 @@ void Mutation::fourInterest(OnMutateFunc cb) {
           !couldBeArith(orig, swap32(INTERESTING_32[j]), 4) &&
           !couldBeInterest(orig, swap32(INTERESTING_32[j]), 4, 1)) {
         *(u32*)(out_buf + i) = swap32(INTERESTING_32[j]);
-        cb(curFuzzItem.data);
+        emit(cb, curFuzzItem.data);
         stageCur ++;
       } else stageMax --;
     }
     *(u32*)(out_buf + i) = orig;
   }
+  flush();
   stageCycles[STAGE_INTEREST32] += stageMax;
 }
 
@@ -390,12 +442,42 @@ void Mutation::overwriteWithDictionary(OnMutateFunc cb) {
       }
       lastLen = extrasLen;
       memcpy(outBuf + i, extrasBuf, lastLen);
-      cb(curFuzzItem.data);
+      emit(cb, curFuzzItem.data);
       stageCur ++;
     }
     /* Restore all the clobbered memory. */
     memcpy(outBuf + i, inBuf + i, lastLen);
   }
+  flush();
+  stageCycles[STAGE_EXTRAS_UO] += stageMax;
+}
+
+/* Runtime values are 32 bytes words, so they only go to word boundaries */
+void Mutation::overwriteWithAutoDictionary(const vector<ExtraData> &extras, OnMutateFunc cb) {
+  stageName = "dict (auto)";
+  stageMax = (dataSize / 32) * extras.size();
+  stageCur = 0;
+  /* Start fuzzing */
+  byte *outBuf = curFuzzItem.data.data();
+  for (u32 i = 0; i + 32 <= (u32)dataSize; i += 32) {
+    if (!memchr(eff.data() + effAPos(i), 1, effSpanALen(i, 32))) {
+      stageMax -= extras.size();
+      continue;
+    }
+    bytes origin(outBuf + i, outBuf + i + 32);
+    for (auto &extra : extras) {
+      if (!memcmp(extra.data.data(), outBuf + i, 32)) {
+        stageMax --;
+        continue;
+      }
+      memcpy(outBuf + i, extra.data.data(), 32);
+      emit(cb, curFuzzItem.data);
+      stageCur ++;
+    }
+    /* Restore all the clobbered memory. */
+    memcpy(outBuf + i, origin.data(), 32);
+  }
+  flush();
   stageCycles[STAGE_EXTRAS_UO] += stageMax;
 }
 
@@ -412,6 +494,10 @@ void Mutation::overwriteWithAddressDictionary(OnMutateFunc cb) {
   u32 extrasCount = dict.extras.size();
   u32 extrasLen = 20;
   for (u32 i = 0; i < (u32)dataSize; i += 32) {
+    if (!isFocused(i)) {
+      stageMax -= extrasCount;
+      continue;
+    }
     for (u32 j = 0; j < extrasCount; j += 1) {
       byte *extrasBuf = dict.extras[j].data.data();
       if (!memcmp(extrasBuf, outBuf + i + 12, extrasLen)) {
@@ -419,12 +505,13 @@ void Mutation::overwriteWithAddressDictionary(OnMutateFunc cb) {
         continue;
       }
       memcpy(outBuf + i + 12, extrasBuf, extrasLen);
-      cb(curFuzzItem.data);
+      emit(cb, curFuzzItem.data);
       stageCur ++;
     }
     /* Restore all the clobbered memory. */
     memcpy(outBuf + i, inBuf + i, 32);
   }
+  flush();
   stageCycles[STAGE_EXTRAS_AO] += stageMax;
 }
 
@@ -575,29 +662,24 @@ void Mutation::havoc(OnMutateFunc cb) {
         }
       }
     }
-    cb(data);
+    emit(cb, data);
     stageCur ++;
     /* Restore to original state */
     data = origin;
   }
+  flush();
   stageCycles[STAGE_HAVOC] += stageMax;
 }
 
-bool Mutation::splice(vector<FuzzItem> queues) {
+bool Mutation::splice(size_t count, SampleFunc sample) {
   u32 spliceCycle = 0;
   s32 firstDiff, lastDiff;
-  bytes origin = curFuzzItem.data;
-  if (queues.size() <= 1) return false;
-  auto numDiff = count_if(queues.begin(), queues.end(), [&](const FuzzItem &item) {
-    return item.res.cksum != queues[0].res.cksum;
-  });
-  if (!numDiff) return false;
+  if (count <= 1) return false;
   while (spliceCycle++ < SPLICE_CYCLES && curFuzzItem.data.size() > 1) {
-    u32 tid, splitAt;
-    do {
-      tid = UR(queues.size());
-    } while (queues[tid].res.cksum == curFuzzItem.res.cksum);
-    FuzzItem target = queues[tid];
+    u32 splitAt;
+    /* Only items of another path are worth splicing with */
+    FuzzItem target = sample(UR(count));
+    if (target.res.cksum == curFuzzItem.res.cksum) continue;
     /* Find a suitable splicing location, somewhere between the first and
      the last differing byte. Bail out if the difference is just a single
      byte or so. */
@@ -617,12 +699,132 @@ bool Mutation::splice(vector<FuzzItem> queues) {
   return false;
 }
 
+/*
+ * Flip every 32 bytes word once and watch the distance of branch: the words
+ * which move it, cover it or stop reaching it are the ones worth mutating
+ */
+bytes Mutation::inferInfluence(const string &branch, OnMutateFunc cb) {
+  stageName = "influence";
+  stageMax = dataSize / 32;
+  auto predicate = curFuzzItem.res.predicates.find(branch);
+  if (predicate == curFuzzItem.res.predicates.end()) return bytes();
+  bytes influence(dataSize, 0);
+  bool found = false;
+  for (stageCur = 0; stageCur < stageMax; stageCur += 1) {
+    auto word = curFuzzItem.data.begin() + stageCur * 32;
+    for (auto it = word; it != word + 32; it ++) *it ^= 0xFF;
+    auto item = cb(curFuzzItem.data);
+    for (auto it = word; it != word + 32; it ++) *it ^= 0xFF;
+    auto it = item.res.predicates.find(branch);
+    if (it == item.res.predicates.end() || it->second != predicate->second) {
+      fill(influence.begin() + stageCur * 32, influence.begin() + (stageCur + 1) * 32, 1);
+      found = true;
+    }
+  }
+  stageCycles[STAGE_INFLUENCE] += stageMax;
+  /* Nothing in the input moves it, the branch depends on state only */
+  return found ? influence : bytes();
+}
+
+/* Restrict the later stages and the effector map to the influencing bytes */
+void Mutation::setFocus(bytes influence) {
+  focus = influence;
+  if (focus.empty()) return;
+  eff = bytes(effALen(dataSize), 0);
+  effCount = 0;
+  for (uint64_t i = 0; i < dataSize; i ++) {
+    if (focus[i] && !eff[effAPos(i)]) {
+      eff[effAPos(i)] = 1;
+      effCount ++;
+    }
+  }
+}
+
+/*
+ * Directed search on the 32 bytes words for an uncovered branch. A word is kept
+ * if +1/-1 (or a sign flip) shrinks the branch distance, then it walks towards
+ * the branch by the linear estimate of the distance, doubling the step when the
+ * distance shrinks slower than that and halving it when overshooting
+ */
+bool Mutation::solve(const string &branch, OnMutateFunc cb) {
+  stageName = "solver";
+  stageMax = SOLVE_MAX_EXECS;
+  stageCur = 0;
+  auto predicate = curFuzzItem.res.predicates.find(branch);
+  if (predicate == curFuzzItem.res.predicates.end()) return false;
+  bytes data = curFuzzItem.data;
+  u256 best = predicate->second;
+  bool solved = false;
+  auto setWord = [&](uint64_t word, u256 value) {
+    auto buf = toBigEndian(value);
+    copy(buf.begin(), buf.end(), data.begin() + word * 32);
+  };
+  /* Distance of the branch with the word set to value */
+  auto run = [&](uint64_t word, u256 value) {
+    setWord(word, value);
+    stageCur ++;
+    auto item = cb(data);
+    if (item.res.tracebits.count(branch)) {
+      solved = true;
+      return u256(0);
+    }
+    auto it = item.res.predicates.find(branch);
+    return it == item.res.predicates.end() ? Invalid256 : it->second;
+  };
+  /* Word 0 holds the lengths of dynamic types, changing it shifts the layout */
+  for (uint64_t word = 1; word < dataSize / 32 && !solved && stageCur < stageMax; word ++) {
+    if (!isFocused(word * 32)) continue;
+    u256 value = fromBigEndian<u256>(bytes(data.begin() + word * 32, data.begin() + (word + 1) * 32));
+    u256 origin = value;
+    /* Find the direction which brings the branch closer, after a sign flip try both */
+    vector<int> directions;
+    u256 candidates[] = { value + 1, value - 1, 0 - value, ~value };
+    for (int i = 0; i < 4 && directions.empty() && !solved; i ++) {
+      auto distance = run(word, candidates[i]);
+      if (distance < best) {
+        value = candidates[i];
+        best = distance;
+        if (i == 0) directions = { 1 };
+        else if (i == 1) directions = { -1 };
+        else directions = { 1, -1 };
+      }
+    }
+    if (directions.empty()) {
+      setWord(word, origin);
+      continue;
+    }
+    for (auto direction : directions) {
+      u256 step = best > 1 ? best - 1 : 1;
+      while (!solved && stageCur < stageMax) {
+        u256 next = direction > 0 ? value + step : value - step;
+        auto distance = run(word, next);
+        if (distance < best) {
+          value = next;
+          best = distance;
+          /* Jump by the remaining distance unless it shrinks slower than the steps */
+          if (best - 1 < step) step = best > 1 ? best - 1 : 1;
+          else if (step < (u256(1) << 255)) step <<= 1;
+        } else if (step > 1) {
+          step >>= 1;
+        } else {
+          break;
+        }
+      }
+    }
+    /* Keep the closest value so that the next words start from there */
+    setWord(word, value);
+  }
+  stageCycles[STAGE_SOLVE] += stageCur;
+  return solved;
+}
+
 void Mutation::random(OnMutateFunc cb) {
   stageName = "random 8/8";
   stageMax = 1;
   for (int i = 0; i < dataSize; i ++) {
     curFuzzItem.data[stageCur] = UR(256);
   }
-  cb(curFuzzItem.data);
+  emit(cb, curFuzzItem.data);
+  flush();
   stageCycles[STAGE_RANDOM] += stageMax;
 }
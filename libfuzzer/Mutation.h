@@ -16,7 +16,16 @@ namespace fuzzer {
     Dicts dicts;
     uint64_t effCount = 0;
     bytes eff;
+    /* Bytes which influence the target branch, empty means all of them */
+    bytes focus;
+    /* Candidates waiting for the batch callback */
+    vector<bytes> pending;
+    OnMutateBatchFunc batchCb;
+    size_t batchSize = 1;
+    void emit(OnMutateFunc cb, const bytes &data);
+    void flush();
     void flipbit(int pos);
+    bool isFocused(uint64_t pos) { return focus.empty() || focus[pos]; }
     public:
       uint64_t dataSize = 0;
       uint64_t stageMax = 0;
@@ -24,6 +33,7 @@ namespace fuzzer {
       string stageName = "";
       static uint64_t stageCycles[32];
       Mutation(FuzzItem item, Dicts dicts);
+      void setBatch(OnMutateBatchFunc batchCb, size_t batchSize);
       void singleWalkingBit(OnMutateFunc cb);
       void twoWalkingBit(OnMutateFunc cb);
       void fourWalkingBit(OnMutateFunc cb);
@@ -38,8 +48,12 @@ namespace fuzzer {
       void fourInterest(OnMutateFunc cb);
       void overwriteWithAddressDictionary(OnMutateFunc cb);
       void overwriteWithDictionary(OnMutateFunc cb);
+      void overwriteWithAutoDictionary(const vector<ExtraData> &extras, OnMutateFunc cb);
       void random(OnMutateFunc cb);
       void havoc(OnMutateFunc cb);
-      bool splice(vector<FuzzItem> items);
+      bool solve(const string &branch, OnMutateFunc cb);
+      bytes inferInfluence(const string &branch, OnMutateFunc cb);
+      void setFocus(bytes influence);
+      bool splice(size_t count, SampleFunc sample);
   };
 }
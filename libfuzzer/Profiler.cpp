@@ -0,0 +1,61 @@
+#include "Profiler.h"
+
+namespace fuzzer {
+  thread_local Profiler::Section Profiler::sections[PROF_COUNT];
+  Profiler::Section Profiler::totals[PROF_COUNT];
+  mutex Profiler::totalsLock;
+  const char* Profiler::names[PROF_COUNT] = {
+    "postprocessTestData",
+    "updateTestData",
+    "encodeFunctions",
+    "constructor",
+    "function",
+    "initialize",
+    "call",
+    "go",
+    "finalize",
+    "onOp",
+    "rollback",
+    "exec",
+    "saveIfInterest"
+  };
+#if defined(__x86_64__) || defined(__i386__)
+  const char* Profiler::unit = "cycles";
+#else
+  const char* Profiler::unit = "ns";
+#endif
+
+  void Profiler::merge() {
+    lock_guard<mutex> guard(totalsLock);
+    for (int i = 0; i < PROF_COUNT; i ++) {
+      totals[i].count += sections[i].count;
+      totals[i].ticks += sections[i].ticks;
+      for (int b = 0; b < NUM_BUCKETS; b ++) totals[i].buckets[b] += sections[i].buckets[b];
+      sections[i] = Section();
+    }
+  }
+
+  pt::ptree Profiler::toJson() {
+    pt::ptree root;
+    merge();
+    lock_guard<mutex> guard(totalsLock);
+    root.put("unit", unit);
+    for (int i = 0; i < PROF_COUNT; i ++) {
+      auto &s = totals[i];
+      if (!s.count) continue;
+      pt::ptree section;
+      pt::ptree histogram;
+      section.put("count", s.count);
+      section.put("ticks", s.ticks);
+      section.put("avgTicks", s.ticks / s.count);
+      /* Bucket b holds hits which took [2^(b-1), 2^b) ticks */
+      for (int b = 0; b < NUM_BUCKETS; b ++) {
+        if (!s.buckets[b]) continue;
+        histogram.put(to_string(b ? 1ull << (b - 1) : 0), s.buckets[b]);
+      }
+      section.add_child("histogram", histogram);
+      root.add_child(names[i], section);
+    }
+    return root;
+  }
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <mutex>
+#include <boost/property_tree/ptree.hpp>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+#include "Common.h"
+
+using namespace std;
+namespace pt = boost::property_tree;
+
+namespace fuzzer {
+  enum ProfileSection {
+    PROF_POSTPROCESS,
+    PROF_UPDATE_TESTDATA,
+    PROF_ENCODE_FUNCTIONS,
+    PROF_CONSTRUCTOR,
+    PROF_FUNCTION,
+    PROF_INITIALIZE,
+    PROF_CALL,
+    PROF_GO,
+    PROF_FINALIZE,
+    PROF_ONOP,
+    PROF_ROLLBACK,
+    PROF_EXEC,
+    PROF_BOOKKEEPING,
+    PROF_COUNT
+  };
+  /*
+   * Tick counters for the fuzzing pipeline. Every section keeps the number
+   * of hits, the total ticks and a log2 histogram of the ticks per hit.
+   * A tick is a cycle on x86 and a nanosecond elsewhere.
+   * Threads count into their own sections and merge them into the totals
+   */
+  class Profiler {
+    public:
+      static const int NUM_BUCKETS = 48;
+      struct Section {
+        uint64_t count = 0;
+        uint64_t ticks = 0;
+        uint64_t buckets[NUM_BUCKETS] = {};
+      };
+      static thread_local Section sections[PROF_COUNT];
+      static Section totals[PROF_COUNT];
+      static mutex totalsLock;
+      static const char* names[PROF_COUNT];
+      static const char* unit;
+      static inline uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+      }
+      static inline void record(ProfileSection section, uint64_t ticks) {
+        auto &s = sections[section];
+        s.count ++;
+        s.ticks += ticks;
+        int bucket = ticks ? 64 - __builtin_clzll(ticks) : 0;
+        s.buckets[bucket < NUM_BUCKETS ? bucket : NUM_BUCKETS - 1] ++;
+      }
+      static void merge();
+      static pt::ptree toJson();
+  };
+
+  class ScopedTimer {
+    ProfileSection section;
+    uint64_t start;
+    public:
+      ScopedTimer(ProfileSection _section): section(_section), start(Profiler::now()) {}
+      ~ScopedTimer() { Profiler::record(section, Profiler::now() - start); }
+  };
+}
+
+/* Timers are compiled out unless the build enables FUZZPROFILE */
+#ifdef FUZZ_PROFILE
+#define FUZZ_PROFILE_CONCAT_(a, b) a##b
+#define FUZZ_PROFILE_CONCAT(a, b) FUZZ_PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(section) fuzzer::ScopedTimer FUZZ_PROFILE_CONCAT(scopedTimer, __LINE__)(section)
+#else
+#define PROFILE_SCOPE(section)
+#endif
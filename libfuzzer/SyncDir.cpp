@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <boost/filesystem.hpp>
+#include "SyncDir.h"
+#include "Checkpoint.h"
+#include "Util.h"
+#include "Logger.h"
+
+namespace fs = boost::filesystem;
+
+namespace fuzzer {
+  /* Entries are named by their sequence number, anything else in a queue is skipped */
+  static bool seqOf(const fs::path &file, uint64_t &seq) {
+    auto name = file.filename().string();
+    if (name.empty() || name.size() > 19 || !all_of(name.begin(), name.end(), ::isdigit)) return false;
+    seq = stoull(name);
+    return true;
+  }
+
+  SyncDir::SyncDir(string _root, string _id, int _interval): root(_root), id(_id), interval(max(_interval, 1)) {
+    auto queue = fs::path(root) / id / "queue";
+    boost::system::error_code ec;
+    fs::create_directories(queue, ec);
+    if (ec) Logger::info("Can not create sync queue " + queue.string() + ": " + ec.message());
+    /* A restarted instance continues its own numbering */
+    fs::directory_iterator it(queue, ec), end;
+    for (; !ec && it != end; it.increment(ec)) {
+      uint64_t seq;
+      if (seqOf(it->path(), seq)) nextSeq = max(nextSeq, seq + 1);
+    }
+    worker = thread([this] { work(); });
+  }
+
+  SyncDir::~SyncDir() {
+    {
+      lock_guard<mutex> guard(lock);
+      stopping = true;
+    }
+    wake.notify_all();
+    worker.join();
+  }
+
+  void SyncDir::publish(uint64_t branch, const bytes &input) {
+    lock_guard<mutex> guard(lock);
+    SyncEntry entry;
+    entry.branch = branch;
+    entry.input = input;
+    outbox.push_back(entry);
+  }
+
+  vector<SyncEntry> SyncDir::take() {
+    lock_guard<mutex> guard(lock);
+    vector<SyncEntry> entries;
+    entries.swap(inbox);
+    return entries;
+  }
+
+  void SyncDir::work() {
+    while (true) {
+      vector<SyncEntry> entries;
+      bool done;
+      {
+        unique_lock<mutex> guard(lock);
+        wake.wait_for(guard, chrono::seconds(interval), [&] { return stopping; });
+        entries.swap(outbox);
+        done = stopping;
+      }
+      /* Entries published before stopping are still written */
+      exportEntries(entries);
+      if (done) return;
+      auto imported = importEntries();
+      lock_guard<mutex> guard(lock);
+      inbox.insert(inbox.end(), imported.begin(), imported.end());
+    }
+  }
+
+  /* One file per entry, renamed into place so peers never read half of it */
+  void SyncDir::exportEntries(const vector<SyncEntry> &entries) {
+    auto queue = fs::path(root) / id / "queue";
+    for (auto &entry : entries) {
+      CheckpointWriter w;
+      w.u64(entry.branch);
+      w.data(entry.input);
+      stringstream name;
+      name << setw(8) << setfill('0') << nextSeq ++;
+      auto file = (queue / name.str()).string();
+      auto tmpFile = (fs::path(root) / id / ("." + name.str())).string();
+      ofstream out(tmpFile, ios::binary);
+      out.write((const char *) w.out().data(), w.out().size());
+      out.close();
+      boost::system::error_code ec;
+      if (out) fs::rename(tmpFile, file, ec);
+      if (!out || ec) {
+        Logger::info("Can not write sync entry " + file);
+        fs::remove(tmpFile, ec);
+      }
+    }
+  }
+
+  vector<SyncEntry> SyncDir::importEntries() {
+    vector<SyncEntry> entries;
+    boost::system::error_code ec;
+    fs::directory_iterator peerIt(root, ec), end;
+    for (; !ec && peerIt != end; peerIt.increment(ec)) {
+      auto peerId = peerIt->path().filename().string();
+      auto queue = peerIt->path() / "queue";
+      boost::system::error_code queueEc;
+      if (peerId == id || !fs::is_directory(queue, queueEc)) continue;
+      auto &peerSeq = peerSeqs[peerId];
+      auto nextPeerSeq = peerSeq;
+      fs::directory_iterator fileIt(queue, queueEc);
+      for (; !queueEc && fileIt != end; fileIt.increment(queueEc)) {
+        uint64_t seq;
+        if (!seqOf(fileIt->path(), seq) || seq < peerSeq) continue;
+        nextPeerSeq = max(nextPeerSeq, seq + 1);
+        ifstream in(fileIt->path().string(), ios::binary);
+        if (!in.is_open()) {
+          Logger::debug("Can not read sync entry " + fileIt->path().string());
+          continue;
+        }
+        bytes data((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+        CheckpointReader r(data);
+        SyncEntry entry;
+        entry.branch = r.u64();
+        entry.input = r.data();
+        if (r.good()) entries.push_back(entry);
+      }
+      peerSeq = nextPeerSeq;
+    }
+    return entries;
+  }
+
+  uint64_t SyncDir::branchKey(const string &branch) {
+    auto pcs = splitString(branch, ':');
+    return stoull(pcs[0]) << 32 | stoull(pcs[1]);
+  }
+
+  string SyncDir::branchOf(uint64_t key) {
+    return to_string(key >> 32) + ":" + to_string(key & 0xffffffff);
+  }
+}
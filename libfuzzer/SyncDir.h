@@ -0,0 +1,47 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "Common.h"
+
+using namespace dev;
+using namespace std;
+
+namespace fuzzer {
+  /* Leader of a covered branch, the branch "from:to" packed as from << 32 | to */
+  struct SyncEntry {
+    uint64_t branch = 0;
+    bytes input;
+  };
+  /*
+   * AFL style sync directory: every instance writes its entries to <root>/<id>/queue
+   * and reads the ones its peers wrote since the last round. Files are only touched
+   * by a worker thread, the fuzz loop hands entries over in memory
+   */
+  class SyncDir {
+      string root;
+      string id;
+      int interval;
+      uint64_t nextSeq = 0;
+      /* Next entry to read from every peer */
+      unordered_map<string, uint64_t> peerSeqs;
+      vector<SyncEntry> outbox;
+      vector<SyncEntry> inbox;
+      mutex lock;
+      condition_variable wake;
+      bool stopping = false;
+      thread worker;
+      void work();
+      void exportEntries(const vector<SyncEntry> &entries);
+      vector<SyncEntry> importEntries();
+    public:
+      SyncDir(string root, string id, int interval);
+      ~SyncDir();
+      void publish(uint64_t branch, const bytes &input);
+      /* Entries of peers read so far */
+      vector<SyncEntry> take();
+      static uint64_t branchKey(const string &branch);
+      static string branchOf(uint64_t key);
+  };
+}
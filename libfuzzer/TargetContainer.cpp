@@ -11,21 +11,20 @@ using namespace fuzzer;
 using namespace boost::multiprecision;
 
 namespace fuzzer {
-  TargetContainer::TargetContainer() {
-    program = new TargetProgram();
+  TargetContainer::TargetContainer(const ForkSource *fork) {
+    program = new TargetProgram(fork);
     oracleFactory = new OracleFactory();
-    baseAddress = ATTACKER_ADDRESS;
+    nextAddress = ASSET_ADDRESS;
+  }
+
+  TargetExecutive TargetContainer::loadContract(bytes code, ContractABI ca, Address addr) {
+    if (!addresses.insert(addr).second) return loadContract(code, ca);
+    return TargetExecutive(oracleFactory, program, addr, ca, code);
   }
 
   TargetExecutive TargetContainer::loadContract(bytes code, ContractABI ca) {
-    if (baseAddress > CONTRACT_ADDRESS) {
-      cout << "> Currently does not allow to load more than 1 asset contract" << endl;
-      exit(0);
-    }
-    Address addr(baseAddress);
-    TargetExecutive te(oracleFactory, program, addr, ca, code);
-    baseAddress ++;
-    return te;
+    while (addresses.count(Address(nextAddress))) nextAddress ++;
+    return loadContract(code, ca, Address(nextAddress));
   }
 
   TargetContainer::~TargetContainer() {
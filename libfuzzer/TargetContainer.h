@@ -11,11 +11,18 @@ namespace fuzzer {
   class TargetContainer {
     TargetProgram *program;
     OracleFactory *oracleFactory;
-    u160 baseAddress;
+    u160 nextAddress;
+    unordered_set<Address> addresses;
     public:
-      TargetContainer();
+      TargetContainer(const ForkSource *fork = nullptr);
       ~TargetContainer();
       vector<bool> analyze() { return oracleFactory->analyze(); }
+      vector<string> oracleNames() { return oracleFactory->names(); }
+      vector<OracleFinding> findings() { return oracleFactory->getFindings(); }
+      u256 blockGasLimit() { return program->blockGasLimit(); }
+      void setAttacker(Address addr, AttackerStrategy strategy) { program->setAttacker(addr, strategy); }
+      /* Load at addr when it is free, at the next free asset address otherwise */
+      TargetExecutive loadContract(bytes code, ContractABI ca, Address addr);
       TargetExecutive loadContract(bytes code, ContractABI ca);
   };
 }
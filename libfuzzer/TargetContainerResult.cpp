@@ -6,11 +6,13 @@ namespace fuzzer {
     unordered_set<string> tracebits,
     unordered_map<string, u256> predicates,
     unordered_set<string> uniqExceptions,
-    string cksum
+    unordered_set<string> uniqHangs,
+    uint64_t cksum
   ) {
     this->tracebits = tracebits;
     this->cksum = cksum;
     this->predicates = predicates;
     this->uniqExceptions = uniqExceptions;
+    this->uniqHangs = uniqHangs;
   }
 }
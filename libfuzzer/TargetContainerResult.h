@@ -14,7 +14,8 @@ namespace fuzzer {
         unordered_set<string> tracebits,
         unordered_map<string, u256> predicates,
         unordered_set<string> uniqExceptions,
-        string cksum
+        unordered_set<string> uniqHangs,
+        uint64_t cksum
     );
 
     /* Contains execution paths */
@@ -23,7 +24,19 @@ namespace fuzzer {
     unordered_map<string, u256> predicates;
     /* Exception path */
     unordered_set<string> uniqExceptions;
-    /* Contains checksum of tracebits */
-    string cksum;
+    /* Pcs where the step limit stopped a transaction */
+    unordered_set<string> uniqHangs;
+    /* Oracles which fired in any transaction */
+    unordered_set<string> oracleHits;
+    /* Gas used by every transaction, the constructor first and 0 for skipped functions */
+    vector<u256> gasUsed;
+    /* Times a loop jumped back, by pc of its jump. Only counted when requested */
+    unordered_map<uint64_t, uint64_t> loopIterations;
+    /* Entries of the state coverage map reached by stores and storages after each transaction */
+    vector<uint32_t> stateBits;
+    /* Seconds spent on this input: the deployment it shares and its own functions */
+    double execTime = 0;
+    /* 64-bit path hash of tracebits */
+    uint64_t cksum = 0;
   };
 }
@@ -1,68 +1,116 @@
+#include <chrono>
 #include "TargetExecutive.h"
 #include "Logger.h"
+#include "Profiler.h"
 
 namespace fuzzer {
+  /*
+   * Gas charged to the budget of a test case. Failing asserts and bad jumps burn
+   * all gas given to the transaction although they did little work
+   */
+  static u256 chargedGas(const ExecutionResult &res) {
+    switch (res.excepted) {
+      case TransactionException::BadInstruction:
+      case TransactionException::BadJumpDestination:
+      case TransactionException::OutOfStack:
+      case TransactionException::StackUnderflow:
+        return 0;
+      default:
+        return res.gasUsed;
+    }
+  }
+
   void TargetExecutive::deploy(bytes data, OnOpFunc onOp) {
     ca.updateTestData(data);
+    ca.wireConstructor(wired);
     program->deploy(addr, bytes{code});
     program->setBalance(addr, DEFAULT_BALANCE);
     program->updateEnv(ca.decodeAccounts(), ca.decodeBlock());
+    program->setGas(gasBudget);
+    program->setStepLimit(stepLimit);
     program->invoke(addr, CONTRACT_CONSTRUCTOR, ca.encodeConstructor(), ca.isPayable(""), onOp);
+    /* The budget only covers the deployment, later transactions get the default gas */
+    program->setGas(MAX_GAS);
   }
 
   TargetContainerResult TargetExecutive::exec(bytes data, const tuple<unordered_set<uint64_t>, unordered_set<uint64_t>>& validJumpis) {
+    return execBatch({ data }, validJumpis)[0];
+  }
+
+  /*
+   * Inputs with the same constructor arguments, accounts and block share the deployment:
+   * the constructor runs once and each input calls its functions from the state it left
+   */
+  vector<TargetContainerResult> TargetExecutive::execBatch(const vector<bytes> &batch, const tuple<unordered_set<uint64_t>, unordered_set<uint64_t>>& validJumpis) {
+    PROFILE_SCOPE(PROF_EXEC);
     /* Save all hit branches to trace_bits */
     Instruction prevInst;
     RecordParam recordParam;
     u256 lastCompValue = 0;
+    u256 lastCompLeft = 0;
+    u256 lastCompRight = 0;
+    bool pendingSha3 = false;
     u64 jumpDest1 = 0;
     u64 jumpDest2 = 0;
     unordered_set<string> uniqExceptions;
+    unordered_set<string> uniqHangs;
+    unordered_set<string> oracleHits;
     unordered_set<string> tracebits;
     unordered_map<string, u256> predicates;
-    vector<bytes> outputs;
+    unordered_map<uint64_t, uint64_t> loopIterations;
+    /* JUMPDESTs passed by every frame of the running transaction, by depth */
+    vector<unordered_set<uint64_t>> frameJumpdests;
+    int frameDepth = -1;
+    vector<uint32_t> stateBits;
+    /* Slots the transaction stored into, their final values update the storage hash */
+    StorageHash storageHash;
+    vector<u256> storedSlots;
+    auto recordStorage = [&]() {
+      if (!stateCoverage) return;
+      for (auto &slot : storedSlots) storageHash.update(slot, program->storageAt(addr, slot));
+      storedSlots.clear();
+      stateBits.push_back(storageHash.index());
+    };
+    /* Branches are only recorded in frames running the code under test, other contracts reuse its pcs */
+    h256 codeHash;
+    auto isTarget = [&](ExtVMFace const* ext) {
+      return recordParam.isDeployment ? ext->myAddress == addr : ext->codeHash == codeHash;
+    };
     size_t savepoint = program->savepoint();
     OnOpFunc onOp = [&](u64, u64 pc, Instruction inst, bigint, bigint, bigint, VMFace const* _vm, ExtVMFace const* ext) {
+      PROFILE_SCOPE(PROF_ONOP);
       auto vm = dynamic_cast<LegacyVM const*>(_vm);
-      /* Oracle analyze data */
-      switch (inst) {
-        case Instruction::CALL:
-        case Instruction::CALLCODE:
-        case Instruction::DELEGATECALL:
-        case Instruction::STATICCALL: {
-          vector<u256>::size_type stackSize = vm->stack().size();
-          u256 wei = (inst == Instruction::CALL || inst == Instruction::CALLCODE) ? vm->stack()[stackSize - 3] : 0;
-          auto sizeOffset = (inst == Instruction::CALL || inst == Instruction::CALLCODE) ? (stackSize - 4) : (stackSize - 3);
-          auto inOff = (uint64_t) vm->stack()[sizeOffset];
-          auto inSize = (uint64_t) vm->stack()[sizeOffset - 1];
-          auto first = vm->memory().begin();
-          OpcodePayload payload;
-          payload.caller = ext->myAddress;
-          payload.callee = Address((u160)vm->stack()[stackSize - 2]);
-          payload.pc = pc;
-          payload.gas = vm->stack()[stackSize - 1];
-          payload.wei = wei;
-          payload.inst = inst;
-          payload.data = bytes(first + inOff, first + inOff + inSize);
-          oracleFactory->save(OpcodeContext(ext->depth + 1, payload));
-          break;
-        }
-        default: {
-          OpcodePayload payload;
-          payload.pc = pc;
-          payload.inst = inst;
-          if (
-              inst == Instruction::SUICIDE ||
-              inst == Instruction::NUMBER ||
-              inst == Instruction::TIMESTAMP ||
-              inst == Instruction::INVALID ||
-              inst == Instruction::ADD ||
-              inst == Instruction::SUB
-              ) {
-            vector<u256>::size_type stackSize = vm->stack().size();
+      /* Oracle analyze data, only opcodes some oracle subscribes to are collected */
+      if (oracleFactory->isSubscribed(inst)) {
+        switch (inst) {
+          case Instruction::CALL:
+          case Instruction::CALLCODE:
+          case Instruction::DELEGATECALL:
+          case Instruction::STATICCALL: {
+            auto hasValue = inst == Instruction::CALL || inst == Instruction::CALLCODE;
+            u256 wei = hasValue ? vm->stackItem(2) : 0;
+            auto sizeOffset = hasValue ? 3 : 2;
+            auto inOff = (uint64_t) vm->stackItem(sizeOffset);
+            auto inSize = (uint64_t) vm->stackItem(sizeOffset + 1);
+            auto first = vm->memory().begin();
+            OpcodePayload payload;
+            payload.caller = ext->myAddress;
+            payload.callee = Address((u160)vm->stackItem(1));
+            payload.pc = pc;
+            payload.gas = vm->stackItem(0);
+            payload.wei = wei;
+            payload.inst = inst;
+            payload.data = bytes(first + inOff, first + inOff + inSize);
+            oracleFactory->save(OpcodeContext(ext->depth + 1, payload));
+            break;
+          }
+          default: {
+            OpcodePayload payload;
+            payload.pc = pc;
+            payload.inst = inst;
             if (inst == Instruction::ADD || inst == Instruction::SUB) {
-              auto left = vm->stack()[stackSize - 1];
-              auto right = vm->stack()[stackSize - 2];
+              auto left = vm->stackItem(0);
+              auto right = vm->stackItem(1);
               if (inst == Instruction::ADD) {
                 auto total256 = left + right;
                 auto total512 = (u512) left + (u512) right;
@@ -73,8 +121,8 @@ namespace fuzzer {
               }
             }
             oracleFactory->save(OpcodeContext(ext->depth + 1, payload));
+            break;
           }
-          break;
         }
       }
       /* Mutation analyzes data */
@@ -84,95 +132,254 @@ namespace fuzzer {
         case Instruction::LT:
         case Instruction::SLT:
         case Instruction::EQ: {
-          vector<u256>::size_type stackSize = vm->stack().size();
-          if (stackSize >= 2) {
-            u256 left = vm->stack()[stackSize - 1];
-            u256 right = vm->stack()[stackSize - 2];
+          if (vm->stackDepth() >= 2) {
+            u256 left = vm->stackItem(0);
+            u256 right = vm->stackItem(1);
             /* calculate if command inside a function */
             u256 temp = left > right ? left - right : right - left;
             lastCompValue = temp + 1;
+            lastCompLeft = left;
+            lastCompRight = right;
           }
           break;
         }
         default: { break; }
       }
+      /* Harvest runtime values for the dictionary */
+      if (autoDict) {
+        /* Stack and memory are read in place, this runs for every opcode */
+        auto stackDepth = vm->stackDepth();
+        /* The hash is on top of the stack when the next opcode starts */
+        if (pendingSha3 && stackDepth) autoDict->add(vm->stackItem(0));
+        pendingSha3 = false;
+        switch (inst) {
+          case Instruction::SHA3: {
+            if (stackDepth < 2) break;
+            /* Runs before the VM expands memory, the range may be anywhere */
+            autoDict->addWords(vm->memory(), vm->stackItem(0), vm->stackItem(1));
+            pendingSha3 = true;
+            break;
+          }
+          case Instruction::SLOAD: {
+            if (stackDepth) autoDict->add(vm->stackItem(0));
+            break;
+          }
+          case Instruction::CALLER: {
+            autoDict->add(u256((u160) ext->caller));
+            break;
+          }
+          case Instruction::ADDRESS: {
+            autoDict->add(u256((u160) ext->myAddress));
+            break;
+          }
+          default: { break; }
+        }
+      }
       /* Calculate left and right branches for valid jumpis*/
       auto recordable = recordParam.isDeployment && get<0>(validJumpis).count(pc);
       recordable = recordable || !recordParam.isDeployment && get<1>(validJumpis).count(pc);
-      if (inst == Instruction::JUMPCI && recordable) {
-        jumpDest1 = (u64) vm->stack().back();
+      if (inst == Instruction::JUMPCI && recordable && isTarget(ext)) {
+        jumpDest1 = (u64) vm->stackItem(0);
         jumpDest2 = pc + 1;
       }
       /* Calculate actual jumpdest and add reverse branch to predicate */
       recordable = recordParam.isDeployment && get<0>(validJumpis).count(recordParam.lastpc);
       recordable = recordable || !recordParam.isDeployment && get<1>(validJumpis).count(recordParam.lastpc);
-      if (prevInst == Instruction::JUMPCI && recordable) {
+      if (prevInst == Instruction::JUMPCI && recordable && isTarget(ext)) {
         auto branchId = to_string(recordParam.lastpc) + ":" + to_string(pc);
         tracebits.insert(branchId);
         /* Calculate branch distance */
         u64 jumpDest = pc == jumpDest1 ? jumpDest2 : jumpDest1;
         branchId = to_string(recordParam.lastpc) + ":" + to_string(jumpDest);
         predicates[branchId] = lastCompValue;
+        if (autoDict) {
+          autoDict->add(lastCompLeft, branchId);
+          autoDict->add(lastCompRight, branchId);
+        }
+      }
+      /* Stores into the storage of the contract under test, read in place */
+      if (stateCoverage && inst == Instruction::SSTORE && ext->myAddress == addr && vm->stackDepth() >= 2) {
+        stateBits.push_back(stateIndex(vm->stackItem(0), vm->stackItem(1)));
+        storedSlots.push_back(vm->stackItem(0));
+      }
+      /*
+       * A taken jump to a lower pc closes an iteration of a loop when it lands on a JUMPDEST
+       * the frame passed before. Internal functions return to a JUMPDEST not passed yet
+       */
+      if (countLoops) {
+        auto depth = (int) ext->depth;
+        if (depth >= (int) frameJumpdests.size()) frameJumpdests.resize(depth + 1);
+        if (depth > frameDepth) frameJumpdests[depth].clear();
+        frameDepth = depth;
+        if (inst == Instruction::JUMPDEST && !frameJumpdests[depth].insert(pc).second && pc < recordParam.lastpc) {
+          switch (prevInst) {
+            case Instruction::JUMP:
+            case Instruction::JUMPI:
+            case Instruction::JUMPC:
+            case Instruction::JUMPCI: {
+              loopIterations[recordParam.lastpc] ++;
+              break;
+            }
+            default: { break; }
+          }
+        }
       }
       prevInst = inst;
       recordParam.lastpc = pc;
     };
-    /* Decode and call functions */
-    ca.updateTestData(data);
-    vector<bytes> funcs = ca.encodeFunctions();
-    program->deploy(addr, code);
-    program->setBalance(addr, DEFAULT_BALANCE);
-    program->updateEnv(ca.decodeAccounts(), ca.decodeBlock());
-    oracleFactory->initialize();
-    /* Record all JUMPI in constructor */
-    recordParam.isDeployment = true;
-    auto sender = ca.getSender();
-    OpcodePayload payload;
-    payload.inst = Instruction::CALL;
-    payload.data = ca.encodeConstructor();
-    payload.wei = ca.isPayable("") ? program->getBalance(sender) / 2 : 0;
-    payload.caller = sender;
-    payload.callee = addr;
-    oracleFactory->save(OpcodeContext(0, payload));
-    auto res = program->invoke(addr, CONTRACT_CONSTRUCTOR, ca.encodeConstructor(), ca.isPayable(""), onOp);
-    if (res.excepted != TransactionException::None) {
-      auto exceptionId = to_string(recordParam.lastpc);
-      uniqExceptions.insert(exceptionId) ;
-      /* Save Call Log */
-      OpcodePayload payload;
-      payload.inst = Instruction::INVALID;
-      oracleFactory->save(OpcodeContext(0, payload));
-    }
-    oracleFactory->finalize();
-    for (uint32_t funcIdx = 0; funcIdx < funcs.size(); funcIdx ++ ) {
-      /* Update payload */
-      auto func = funcs[funcIdx];
-      auto fd = ca.fds[funcIdx];
-      /* Ignore JUMPI until program reaches inside function */
-      recordParam.isDeployment = false;
+    /* Constructor has no encoded function */
+    vector<FuncDef> fds;
+    copy_if(ca.fds.begin(), ca.fds.end(), back_inserter(fds), [](const FuncDef &fd) { return fd.name != ""; });
+    vector<TargetContainerResult> results;
+    size_t loaded = batch.size();
+    auto load = [&](size_t idx) {
+      PROFILE_SCOPE(PROF_UPDATE_TESTDATA);
+      if (loaded != idx) {
+        ca.updateTestData(batch[idx]);
+        ca.wireConstructor(wired);
+      }
+      loaded = idx;
+    };
+    for (size_t first = 0; first < batch.size(); ) {
+      load(first);
+      auto prefix = make_tuple(ca.encodeConstructor(), ca.decodeAccounts(), ca.decodeBlock());
+      tracebits.clear();
+      predicates.clear();
+      uniqExceptions.clear();
+      uniqHangs.clear();
+      oracleHits.clear();
+      loopIterations.clear();
+      stateBits.clear();
+      storageHash = StorageHash();
+      storedSlots.clear();
+      program->deploy(addr, code);
+      program->setBalance(addr, DEFAULT_BALANCE);
+      program->updateEnv(ca.decodeAccounts(), ca.decodeBlock());
+      oracleFactory->setTestcase(batch[first]);
+      oracleFactory->initialize();
+      /* Record all JUMPI in constructor */
+      recordParam.isDeployment = true;
+      auto sender = ca.getSender();
       OpcodePayload payload;
-      payload.data = func;
       payload.inst = Instruction::CALL;
-      payload.wei = ca.isPayable(fd.name) ? program->getBalance(sender) / 2 : 0;
+      payload.data = ca.encodeConstructor();
+      payload.wei = ca.isPayable("") ? program->getBalance(sender) / 2 : 0;
       payload.caller = sender;
       payload.callee = addr;
       oracleFactory->save(OpcodeContext(0, payload));
-      res = program->invoke(addr, CONTRACT_FUNCTION, func, ca.isPayable(fd.name), onOp);
-      outputs.push_back(res.output);
-      if (res.excepted != TransactionException::None) {
+      ExecutionResult res;
+      auto deployStart = chrono::steady_clock::now();
+      u256 deployGasLeft = gasBudget;
+      program->setGas(deployGasLeft);
+      program->setStepLimit(stepLimit);
+      {
+        PROFILE_SCOPE(PROF_CONSTRUCTOR);
+        frameDepth = -1;
+        res = program->invoke(addr, CONTRACT_CONSTRUCTOR, ca.encodeConstructor(), ca.isPayable(""), onOp);
+      }
+      if (res.excepted == TransactionException::StepLimitReached) {
+        uniqHangs.insert(to_string(recordParam.lastpc));
+      } else if (res.excepted != TransactionException::None) {
         auto exceptionId = to_string(recordParam.lastpc);
-        uniqExceptions.insert(exceptionId);
+        uniqExceptions.insert(exceptionId) ;
         /* Save Call Log */
         OpcodePayload payload;
         payload.inst = Instruction::INVALID;
         oracleFactory->save(OpcodeContext(0, payload));
       }
-      oracleFactory->finalize();
+      for (auto name : oracleFactory->finalize()) oracleHits.insert(name);
+      deployGasLeft -= min(deployGasLeft, chargedGas(res));
+      auto deployGasUsed = res.gasUsed;
+      recordStorage();
+      codeHash = sha3(program->getCode(addr));
+      auto deployTime = chrono::steady_clock::now() - deployStart;
+      /* Every input of the group starts from what the constructor left */
+      auto deployTracebits = tracebits;
+      auto deployPredicates = predicates;
+      auto deployExceptions = uniqExceptions;
+      auto deployHangs = uniqHangs;
+      auto deployOracleHits = oracleHits;
+      auto deployLoopIterations = loopIterations;
+      auto deployStateBits = stateBits;
+      auto deployStorageHash = storageHash;
+      size_t deploySavepoint = program->savepoint();
+      size_t last = first;
+      for (; last < batch.size(); last ++) {
+        auto execStart = chrono::steady_clock::now();
+        if (last != first) {
+          load(last);
+          if (make_tuple(ca.encodeConstructor(), ca.decodeAccounts(), ca.decodeBlock()) != prefix) break;
+          tracebits = deployTracebits;
+          predicates = deployPredicates;
+          uniqExceptions = deployExceptions;
+          uniqHangs = deployHangs;
+          oracleHits = deployOracleHits;
+          loopIterations = deployLoopIterations;
+          stateBits = deployStateBits;
+          storageHash = deployStorageHash;
+          oracleFactory->setTestcase(batch[last]);
+        }
+        /* Decode and call functions */
+        vector<bytes> funcs;
+        {
+          PROFILE_SCOPE(PROF_ENCODE_FUNCTIONS);
+          funcs = ca.encodeFunctions();
+        }
+        u256 gasLeft = deployGasLeft;
+        vector<u256> gasUsed(funcs.size() + 1, 0);
+        gasUsed[0] = deployGasUsed;
+        for (uint32_t funcIdx = 0; funcIdx < funcs.size() && gasLeft; funcIdx ++ ) {
+          if (funcIdx < funcMask.size() && !funcMask[funcIdx]) continue;
+          /* Update payload */
+          auto func = funcs[funcIdx];
+          auto fd = fds[funcIdx];
+          /* Ignore JUMPI until program reaches inside function */
+          recordParam.isDeployment = false;
+          oracleFactory->initialize(funcIdx + 1);
+          OpcodePayload payload;
+          payload.data = func;
+          payload.inst = Instruction::CALL;
+          payload.wei = ca.isPayable(fd.name) ? program->getBalance(sender) / 2 : 0;
+          payload.caller = sender;
+          payload.callee = addr;
+          oracleFactory->save(OpcodeContext(0, payload));
+          program->setGas(gasLeft);
+          {
+            PROFILE_SCOPE(PROF_FUNCTION);
+            frameDepth = -1;
+            res = program->invoke(addr, CONTRACT_FUNCTION, func, ca.isPayable(fd.name), onOp);
+          }
+          if (res.excepted == TransactionException::StepLimitReached) {
+            uniqHangs.insert(to_string(recordParam.lastpc));
+          } else if (res.excepted != TransactionException::None) {
+            auto exceptionId = to_string(recordParam.lastpc);
+            uniqExceptions.insert(exceptionId);
+            /* Save Call Log */
+            OpcodePayload payload;
+            payload.inst = Instruction::INVALID;
+            oracleFactory->save(OpcodeContext(0, payload));
+          }
+          for (auto name : oracleFactory->finalize()) oracleHits.insert(name);
+          gasLeft -= min(gasLeft, chargedGas(res));
+          gasUsed[funcIdx + 1] = res.gasUsed;
+          recordStorage();
+        }
+        results.push_back(TargetContainerResult(tracebits, predicates, uniqExceptions, uniqHangs, hashTracebits(tracebits)));
+        results.back().oracleHits = oracleHits;
+        results.back().gasUsed = gasUsed;
+        results.back().loopIterations = loopIterations;
+        results.back().stateBits = stateBits;
+        results.back().execTime = chrono::duration<double>(deployTime + chrono::steady_clock::now() - execStart).count();
+        PROFILE_SCOPE(PROF_ROLLBACK);
+        program->rollback(deploySavepoint);
+      }
+      /* Reset data before running new contract */
+      {
+        PROFILE_SCOPE(PROF_ROLLBACK);
+        program->rollback(savepoint);
+      }
+      first = last;
     }
-    /* Reset data before running new contract */
-    program->rollback(savepoint);
-    string cksum = "";
-    for (auto t : tracebits) cksum = cksum + t;
-    return TargetContainerResult(tracebits, predicates, uniqExceptions, cksum);
+    return results;
   }
 }
@@ -6,6 +6,7 @@
 #include "TargetProgram.h"
 #include "ContractABI.h"
 #include "TargetContainerResult.h"
+#include "Dictionary.h"
 #include "Util.h"
 
 using namespace dev;
@@ -24,6 +25,20 @@ namespace fuzzer {
       bytes code;
     public:
       Address addr;
+      /* Gas shared by the constructor and all functions of a test case */
+      u256 gasBudget = MAX_GAS;
+      /* Steps a single transaction may take including its nested calls, 0 means unlimited */
+      uint64_t stepLimit = 0;
+      /* Collects runtime values while executing when set */
+      AutoDictionary *autoDict = nullptr;
+      /* Functions to call in encodeFunctions order, empty calls all of them */
+      vector<bool> funcMask;
+      /* Count the backward jumps of loops into the result */
+      bool countLoops = false;
+      /* Record stores and storages after each transaction into the state coverage map */
+      bool stateCoverage = false;
+      /* Contracts deployed before, wired into the address arguments of the constructor */
+      vector<DeployedContract> wired;
       TargetExecutive(OracleFactory *oracleFactory, TargetProgram *program, Address addr, ContractABI ca, bytes code) {
         this->code = code;
         this->ca = ca;
@@ -32,6 +47,8 @@ namespace fuzzer {
         this->oracleFactory = oracleFactory;
       }
       TargetContainerResult exec(bytes data, const tuple<unordered_set<uint64_t>, unordered_set<uint64_t>> &validJumpis);
+      vector<TargetContainerResult> execBatch(const vector<bytes> &batch, const tuple<unordered_set<uint64_t>, unordered_set<uint64_t>> &validJumpis);
+      /* Deploy with the wired contracts passed to the constructor */
       void deploy(bytes data, OnOpFunc onOp);
   };
 }
@@ -1,22 +1,32 @@
 #include "TargetProgram.h"
 #include "Util.h"
+#include "Profiler.h"
 
 using namespace dev;
 using namespace eth;
 
 namespace fuzzer {
-  TargetProgram::TargetProgram(): state(State(0)) {
-    Network networkName = Network::MainNetworkTest;
+  ForkSource::ForkSource(string path, h256 _root): root(_root) {
+    auto genesis = BlockHeader(ChainParams(genesisInfo(Network::MainNetwork)).genesisBlock()).hash();
+    db = State::openDB(path, genesis, WithExisting::Trust);
+  }
+
+  /*
+   * A fork starts from the root of the database. The state caches what it reads and
+   * rollbacks undo the changelog only, so execs never copy the world state
+   */
+  TargetProgram::TargetProgram(const ForkSource *fork): state(fork ? State(0, fork->db, BaseState::PreExisting) : State(0)) {
+    if (fork) state.setRoot(fork->root);
     LastBlockHashes lastBlockHashes;
     BlockHeader blockHeader;
-    s64 maxGasLimit = ChainParams(genesisInfo(networkName))
-      .maxGasLimit.convert_to<s64>();
+    s64 maxGasLimit = chainParams().maxGasLimit.convert_to<s64>();
     gas = MAX_GAS;
+    stepLimit = 0;
     timestamp = 0;
     blockNumber = 2675000;
     Ethash::init();
     NoProof::init();
-    se = ChainParams(genesisInfo(networkName)).createSealEngine();
+    se = chainParams().createSealEngine();
     // add value
     blockHeader.setGasLimit(maxGasLimit);
     blockHeader.setTimestamp(timestamp);
@@ -24,9 +34,27 @@ namespace fuzzer {
     envInfo = new EnvInfo(blockHeader, lastBlockHashes, 0);
   }
   
+  /* Parsing the genesis takes milliseconds, all programs share the parsed one */
+  ChainParams const& TargetProgram::chainParams() {
+    static ChainParams params(genesisInfo(Network::MainNetworkTest));
+    return params;
+  }
+
   void TargetProgram::setBalance(Address addr, u256 balance) {
     state.setBalance(addr, balance);
   }
+
+  void TargetProgram::setGas(u256 _gas) {
+    gas = _gas;
+  }
+
+  void TargetProgram::setStepLimit(uint64_t _stepLimit) {
+    stepLimit = _stepLimit;
+  }
+
+  void TargetProgram::setAttacker(Address addr, AttackerStrategy strategy) {
+    attacker.strategies[addr] = strategy;
+  }
     
   u256 TargetProgram::getBalance(Address addr) {
     return state.balance(addr);
@@ -40,6 +68,10 @@ namespace fuzzer {
   bytes TargetProgram::getCode(Address addr) {
     return state.code(addr);
   }
+
+  u256 TargetProgram::storageAt(Address const& addr, u256 const& slot) {
+    return state.storage(addr, slot);
+  }
   
   ExecutionResult TargetProgram::invoke(Address addr, ContractCall type, bytes data, bool payable, OnOpFunc onOp) {
     switch (type) {
@@ -67,14 +99,38 @@ namespace fuzzer {
     u256 gasPrice = 0;
     Transaction t = Transaction(value, gasPrice, gas, data, state.getNonce(sender));
     t.forceSender(senderAddr);
+    /* Budget of test case is exhausted, do not even start the transaction */
+    if (gas < (u256) t.baseGasRequired(se->evmSchedule(blockNumber))) {
+      res.excepted = TransactionException::OutOfGasIntrinsic;
+      return res;
+    }
+    /* Steps are shared by the transaction and all of its nested calls */
+    StepBudget stepBudget;
+    stepBudget.limit = stepLimit;
     Executive executive(state, *envInfo, *se);
     executive.setResultRecipient(res);
-    executive.initialize(t);
-    LegacyVM::payload = data;
-    executive.call(addr, senderAddr, value, gasPrice, &data, gas);
+    executive.setStepBudget(&stepBudget);
+    /* Attackers of this program see the calldata of the transaction while it executes */
+    attacker.payload = bytesConstRef(&data);
+    ScopeGuard clearPayload([this] { attacker.payload = bytesConstRef(); });
+    executive.setAttacker(&attacker);
+    {
+      PROFILE_SCOPE(PROF_INITIALIZE);
+      executive.initialize(t);
+    }
+    {
+      PROFILE_SCOPE(PROF_CALL);
+      executive.call(addr, senderAddr, value, gasPrice, &data, gas);
+    }
     executive.updateBlock(blockNumber, timestamp);
-    executive.go(onOp);
-    executive.finalize();
+    {
+      PROFILE_SCOPE(PROF_GO);
+      executive.go(onOp);
+    }
+    {
+      PROFILE_SCOPE(PROF_FINALIZE);
+      executive.finalize();
+    }
     return res;
   }
 
@@ -10,23 +10,41 @@ using namespace std;
 
 namespace fuzzer {
   enum ContractCall { CONTRACT_CONSTRUCTOR, CONTRACT_FUNCTION };
+  /*
+   * World state of an existing aleth chain database at a state root. It is opened once,
+   * programs forking it share the database and fault in accounts and slots on first use
+   */
+  struct ForkSource {
+    OverlayDB db;
+    h256 root;
+    ForkSource(string path, h256 root);
+    /* A root missing from the database can not be forked, State throws RootNotFound on it */
+    bool hasRoot() const { return db.exists(root); }
+  };
   class TargetProgram {
     private:
       State state;
       u256 gas;
+      uint64_t stepLimit;
       int64_t timestamp;
       int64_t blockNumber;
       u160 sender;
       EnvInfo *envInfo;
       SealEngineFace *se;
+      AttackerContext attacker;
       ExecutionResult invoke(Address addr, bytes data, bool payable, OnOpFunc onOp);
     public:
-      TargetProgram();
+      TargetProgram(const ForkSource *fork);
+      static ChainParams const& chainParams();
       ~TargetProgram();
       u256 getBalance(Address addr);
       bytes getCode(Address addr);
-      map<h256, pair<u256, u256>> storage(Address const& addr);
+      u256 storageAt(Address const& addr, u256 const& slot);
       void setBalance(Address addr, u256 balance);
+      void setGas(u256 gas);
+      void setStepLimit(uint64_t stepLimit);
+      void setAttacker(Address addr, AttackerStrategy strategy);
+      u256 blockGasLimit() { return envInfo->gasLimit(); }
       void deploy(Address addr, bytes code);
       void updateEnv(Accounts accounts, FakeBlock block);
       unordered_map<Address, u256> addresses();
@@ -193,5 +193,63 @@ namespace fuzzer {
     return elements;
   }
 
+  uint64_t hashBytes(const byte *data, size_t len) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < len; i ++) {
+      hash ^= data[i];
+      hash *= 0x100000001b3ull;
+    }
+    return hash;
+  }
+
+  static uint64_t mix(uint64_t h) {
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+    return h ^ (h >> 31);
+  }
+
+  uint64_t hashTracebits(const unordered_set<string> &tracebits) {
+    uint64_t hash = 0;
+    /* Mix every branch so that sums of different sets rarely collide */
+    for (auto &tracebit : tracebits) hash += mix(hashBytes((const byte *) tracebit.data(), tracebit.size()));
+    return hash;
+  }
+
+  uint8_t valueClass(const u256 &value) {
+    if (value == 0) return 0;
+    if (value == 1) return 1;
+    if (value <= 0xff) return 2;
+    if (value == ~u256(0)) return 4;
+    if (value >> 160 == 0) return 3;
+    return 5;
+  }
+
+  static uint64_t hashState(const u256 &slot, const u256 &value) {
+    h256 word(slot);
+    return mix(hashBytes(word.data(), word.size) ^ valueClass(value));
+  }
+
+  uint32_t stateIndex(const u256 &slot, const u256 &value) {
+    return hashState(slot, value) & (STATE_MAP_SIZE - 1);
+  }
+
+  void StorageHash::update(const u256 &slot, const u256 &value) {
+    auto it = values.find(slot);
+    if (it != values.end()) {
+      if (it->second == value) return;
+      hash -= hashState(slot, it->second);
+      values.erase(it);
+    }
+    if (value) {
+      hash += hashState(slot, value);
+      values[slot] = value;
+    }
+  }
+
+  uint32_t StorageHash::index() const {
+    /* Keep it apart from the index of a single slot */
+    return mix(hash ^ 0x9e3779b97f4a7c15ull) & (STATE_MAP_SIZE - 1);
+  }
+
 }
 
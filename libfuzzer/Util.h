@@ -48,13 +48,27 @@ namespace fuzzer {
   typedef int64_t  s64;
   
   static u256 MAX_GAS = 100000000000;
+  /* An exec is slow if it takes SLOW_EXEC_FACTOR times the average and at least SLOW_EXEC_MIN seconds */
+  static double SLOW_EXEC_FACTOR = 20;
+  static double SLOW_EXEC_MIN = 0.01;
+  static int SLOW_EXEC_WARMUP = 100;
+  /* One exec round in FULL_EXEC_INTERVAL calls every function, others only those reaching uncovered branches */
+  static int FULL_EXEC_INTERVAL = 16;
   static u160 ATTACKER_ADDRESS = 0xf0;
   static u160 CONTRACT_ADDRESS = 0xf1;
+  /* Other asset contracts are loaded from here on */
+  static u160 ASSET_ADDRESS = 0x100;
   static u256 DEFAULT_BALANCE = 0xffffffffff;
   static OnOpFunc EMPTY_ONOP = [](u64, u64, Instruction, bigint, bigint, bigint, VMFace const*, ExtVMFace const*) {};
 
   static u32 SPLICE_CYCLES = 15;
   static u32 MAX_DET_EXTRAS = 200;
+  /* Size of the runtime dictionary, values kept per branch and entries used per leader */
+  static size_t AUTO_DICT_MAX = 512;
+  static size_t AUTO_DICT_BRANCH_MAX = 8;
+  static size_t AUTO_DICT_TOP = 16;
+  /* Entries of the state coverage map, a power of two */
+  static uint32_t STATE_MAP_SIZE = 1 << 16;
   static int STAGE_FLIP1 = 0;
   static int STAGE_FLIP2 = 1;
   static int STAGE_FLIP4 = 2;
@@ -71,8 +85,14 @@ namespace fuzzer {
   static int STAGE_EXTRAS_AO = 14;
   static int STAGE_HAVOC = 15;
   static int STAGE_RANDOM = 16;
+  static int STAGE_SOLVE = 17;
+  static int STAGE_INFLUENCE = 18;
+  static int STAGE_SYNC = 19;
   static int HAVOC_STACK_POW2 = 7;
   static int HAVOC_MIN = 16;
+  static int SOLVE_MAX_EXECS = 512;
+  static uint64_t MINIMIZE_MAX_EXECS = 1024;
+  static uint64_t TRIM_MAX_EXECS = 128;
   static int EFF_MAP_SCALE2 = 4; // 32 bytes block
   static int ARITH_MAX = 35;
   static int EFF_MAX_PERC = 90;
@@ -105,5 +125,31 @@ namespace fuzzer {
   struct ExtraData {
     bytes data;
   };
+  /* Static reach of a public function, unknown when its selector is not in the dispatcher */
+  struct FunctionReach {
+    bool known = false;
+    bool writesState = false;
+    unordered_set<uint64_t> jumpis;
+  };
   vector<string> splitString(string str, char separator);
+  /* FNV-1a of a byte range */
+  uint64_t hashBytes(const byte *data, size_t len);
+  /* Order independent hash of a set of branches */
+  uint64_t hashTracebits(const unordered_set<string> &tracebits);
+  /* Coarse class of a stored value: zero, one, small, address sized, all ones or large */
+  uint8_t valueClass(const u256 &value);
+  /* Index of a (slot, value class) pair in the state coverage map */
+  uint32_t stateIndex(const u256 &slot, const u256 &value);
+  /*
+   * Abstract state of a whole storage, every slot reduced to its value class. The hash is
+   * order independent and kept up to date slot by slot, storage is never walked
+   */
+  struct StorageHash {
+    uint64_t hash = 0;
+    /* Values the hash accounts for, slots not in it are zero */
+    map<u256, u256> values;
+    void update(const u256 &slot, const u256 &value);
+    /* Index in the state coverage map */
+    uint32_t index() const;
+  };
 }
@@ -0,0 +1,37 @@
+#pragma once
+#include <iostream>
+#include "Common.h"
+
+using namespace dev;
+using namespace eth;
+using namespace std;
+
+struct OracleFinding {
+  string oracle;
+  /* Transaction which triggered the oracle, 0 is the constructor */
+  uint64_t functionIdx = 0;
+  /* Pc of the event that proves the finding */
+  u256 pc = 0;
+  Instruction inst = Instruction::STOP;
+  /* Test case which triggered the oracle */
+  bytes testcase;
+};
+
+/*
+ * A detector receives the contexts of the opcodes it subscribes to, one function
+ * at a time, and tells after every function whether that function is vulnerable
+ */
+class Oracle {
+  protected:
+    /* Event that proves the finding, set by the oracle */
+    OpcodePayload witness;
+  public:
+    virtual ~Oracle() {}
+    virtual string name() const = 0;
+    virtual vector<Instruction> subscriptions() const = 0;
+    virtual void onEvent(const OpcodeContext &ctx) = 0;
+    virtual bool isVulnerable() const = 0;
+    /* Forget the state of the current function */
+    virtual void reset() = 0;
+    const OpcodePayload& getWitness() const { return witness; }
+};
@@ -1,18 +1,35 @@
 #pragma once
 #include <iostream>
+#include <memory>
 #include "Common.h"
+#include "Oracles.h"
 
 using namespace dev;
 using namespace eth;
 using namespace std;
 
+/*
+ * Dispatches every saved context to the oracles subscribed to its opcode, so
+ * the analysis costs one pass over the events whatever the number of oracles
+ */
 class OracleFactory {
-    MultipleFunction functions;
-    SingleFunction function;
+    vector<unique_ptr<Oracle>> oracles;
+    vector<Oracle*> subscribers[256];
     vector<bool> vulnerabilities;
+    vector<OracleFinding> findings;
+    uint64_t functionIdx = 0;
+    bytes testcase;
   public:
-    void initialize();
-    void finalize();
-    void save(OpcodeContext ctx);
+    OracleFactory();
+    void add(unique_ptr<Oracle> oracle);
+    bool isSubscribed(Instruction inst) const { return !subscribers[(uint8_t) inst].empty(); }
+    /* Start transaction functionIdx of the current test case, 0 is the constructor */
+    void initialize(uint64_t functionIdx = 0);
+    void setTestcase(const bytes &data) { testcase = data; }
+    /* Names of the oracles which fired in the transaction */
+    vector<string> finalize();
+    void save(const OpcodeContext &ctx);
     vector<bool> analyze();
+    vector<string> names() const;
+    const vector<OracleFinding>& getFindings() const { return findings; }
 };
@@ -0,0 +1,108 @@
+#include "Oracles.h"
+
+using namespace dev;
+using namespace eth;
+using namespace std;
+
+static const vector<Instruction> CALL_INSTS = {
+  Instruction::CALL, Instruction::CALLCODE, Instruction::DELEGATECALL, Instruction::STATICCALL
+};
+
+void GaslessSendOracle::onEvent(const OpcodeContext &ctx) {
+  auto gas = ctx.payload.gas;
+  if (!found && ctx.level == 1 && !ctx.payload.data.size() && (gas == 2300 || gas == 0)) {
+    found = true;
+    witness = ctx.payload;
+  }
+}
+
+void ExceptionDisorderOracle::onEvent(const OpcodeContext &ctx) {
+  /* Level 0 is the exception of the root call, it is always the last event */
+  if (!ctx.level) {
+    rootException = true;
+  } else if (!nestedException) {
+    nestedException = true;
+    witness = ctx.payload;
+  }
+}
+
+vector<Instruction> BlockDependencyOracle::subscriptions() const {
+  auto insts = CALL_INSTS;
+  insts.push_back(property);
+  return insts;
+}
+
+void BlockDependencyOracle::onEvent(const OpcodeContext &ctx) {
+  if (ctx.payload.inst == property) {
+    if (!hasProperty) witness = ctx.payload;
+    hasProperty = true;
+  }
+  hasTransfer = hasTransfer || ctx.payload.wei > 0;
+}
+
+vector<Instruction> ReentrancyOracle::subscriptions() const {
+  return CALL_INSTS;
+}
+
+void ReentrancyOracle::onEvent(const OpcodeContext &ctx) {
+  if (!hasLoop && ctx.level >= 4 && toHex(ctx.payload.data) == "000000ff") {
+    hasLoop = true;
+    witness = ctx.payload;
+  }
+  hasTransfer = hasTransfer || ctx.payload.wei > 0;
+}
+
+void DelegateCallOracle::onEvent(const OpcodeContext &ctx) {
+  /* Every function starts with its root call */
+  if (!ctx.level) {
+    root = ctx.payload;
+    return;
+  }
+  if (found || ctx.payload.inst != Instruction::DELEGATECALL) return;
+  found = root.data == ctx.payload.data
+    || root.caller == ctx.payload.callee
+    || toHex(root.data).find(toHex(ctx.payload.callee)) != string::npos;
+  if (found) witness = ctx.payload;
+}
+
+vector<Instruction> FreezingOracle::subscriptions() const {
+  return { Instruction::DELEGATECALL, Instruction::CALL, Instruction::CALLCODE, Instruction::SUICIDE };
+}
+
+void FreezingOracle::onEvent(const OpcodeContext &ctx) {
+  auto inst = ctx.payload.inst;
+  if (inst == Instruction::DELEGATECALL) {
+    if (!hasDelegate) witness = ctx.payload;
+    hasDelegate = true;
+  } else if (ctx.level == 1) {
+    hasTransfer = true;
+  }
+}
+
+void OverflowOracle::onEvent(const OpcodeContext &ctx) {
+  if (!found && ctx.payload.isOverflow) {
+    found = true;
+    witness = ctx.payload;
+  }
+}
+
+void UnderflowOracle::onEvent(const OpcodeContext &ctx) {
+  if (!found && ctx.payload.isUnderflow) {
+    found = true;
+    witness = ctx.payload;
+  }
+}
+
+vector<unique_ptr<Oracle>> defaultOracles() {
+  vector<unique_ptr<Oracle>> oracles;
+  oracles.emplace_back(new GaslessSendOracle());
+  oracles.emplace_back(new ExceptionDisorderOracle());
+  oracles.emplace_back(new ReentrancyOracle());
+  oracles.emplace_back(new BlockDependencyOracle("timestamp dependency", Instruction::TIMESTAMP));
+  oracles.emplace_back(new BlockDependencyOracle("block number dependency", Instruction::NUMBER));
+  oracles.emplace_back(new DelegateCallOracle());
+  oracles.emplace_back(new FreezingOracle());
+  oracles.emplace_back(new OverflowOracle());
+  oracles.emplace_back(new UnderflowOracle());
+  return oracles;
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include <memory>
+#include "Oracle.h"
+
+using namespace dev;
+using namespace eth;
+using namespace std;
+
+/* Send to a fallback without data and with the gas stipend or no gas */
+class GaslessSendOracle: public Oracle {
+    bool found = false;
+  public:
+    string name() const override { return "gasless send"; }
+    vector<Instruction> subscriptions() const override { return { Instruction::CALL }; }
+    void onEvent(const OpcodeContext &ctx) override;
+    bool isVulnerable() const override { return found; }
+    void reset() override { found = false; }
+};
+
+/* A nested call throws but the root call does not */
+class ExceptionDisorderOracle: public Oracle {
+    bool rootException = false;
+    bool nestedException = false;
+  public:
+    string name() const override { return "exception disorder"; }
+    vector<Instruction> subscriptions() const override { return { Instruction::INVALID }; }
+    void onEvent(const OpcodeContext &ctx) override;
+    bool isVulnerable() const override { return !rootException && nestedException; }
+    void reset() override { rootException = nestedException = false; }
+};
+
+/* Ether moves in a function which reads a block property */
+class BlockDependencyOracle: public Oracle {
+    string oracleName;
+    Instruction property;
+    bool hasTransfer = false;
+    bool hasProperty = false;
+  public:
+    BlockDependencyOracle(string _oracleName, Instruction _property): oracleName(_oracleName), property(_property) {}
+    string name() const override { return oracleName; }
+    vector<Instruction> subscriptions() const override;
+    void onEvent(const OpcodeContext &ctx) override;
+    bool isVulnerable() const override { return hasTransfer && hasProperty; }
+    void reset() override { hasTransfer = hasProperty = false; }
+};
+
+/* Ether moves in a function whose calls re-enter the attacker deep enough */
+class ReentrancyOracle: public Oracle {
+    bool hasLoop = false;
+    bool hasTransfer = false;
+  public:
+    string name() const override { return "reentrancy"; }
+    vector<Instruction> subscriptions() const override;
+    void onEvent(const OpcodeContext &ctx) override;
+    bool isVulnerable() const override { return hasLoop && hasTransfer; }
+    void reset() override { hasLoop = hasTransfer = false; }
+};
+
+/* DELEGATECALL to an address or with data controlled by the caller */
+class DelegateCallOracle: public Oracle {
+    OpcodePayload root;
+    bool found = false;
+  public:
+    string name() const override { return "dangerous delegatecall"; }
+    vector<Instruction> subscriptions() const override { return { Instruction::CALL, Instruction::DELEGATECALL }; }
+    void onEvent(const OpcodeContext &ctx) override;
+    bool isVulnerable() const override { return found; }
+    void reset() override { found = false; }
+};
+
+/* Ether can only leave the contract through DELEGATECALL */
+class FreezingOracle: public Oracle {
+    bool hasDelegate = false;
+    bool hasTransfer = false;
+  public:
+    string name() const override { return "freezing ether"; }
+    vector<Instruction> subscriptions() const override;
+    void onEvent(const OpcodeContext &ctx) override;
+    bool isVulnerable() const override { return hasDelegate && !hasTransfer; }
+    void reset() override { hasDelegate = hasTransfer = false; }
+};
+
+class OverflowOracle: public Oracle {
+    bool found = false;
+  public:
+    string name() const override { return "integer overflow"; }
+    vector<Instruction> subscriptions() const override { return { Instruction::ADD }; }
+    void onEvent(const OpcodeContext &ctx) override;
+    bool isVulnerable() const override { return found; }
+    void reset() override { found = false; }
+};
+
+class UnderflowOracle: public Oracle {
+    bool found = false;
+  public:
+    string name() const override { return "integer underflow"; }
+    vector<Instruction> subscriptions() const override { return { Instruction::SUB }; }
+    void onEvent(const OpcodeContext &ctx) override;
+    bool isVulnerable() const override { return found; }
+    void reset() override { found = false; }
+};
+
+/* Built-in oracles, in the order they are shown */
+vector<unique_ptr<Oracle>> defaultOracles();
@@ -113,6 +113,10 @@ BOOST_AUTO_TEST_CASE(transactionExceptionOutput)
     BOOST_CHECK_MESSAGE(buffer.str() == "StackUnderflow", "Error output TransactionException::StackUnderflow");
     buffer.str(std::string());
 
+    buffer << TransactionException::StepLimitReached;
+    BOOST_CHECK_MESSAGE(buffer.str() == "StepLimitReached", "Error output TransactionException::StepLimitReached");
+    buffer.str(std::string());
+
     buffer << TransactionException(-1);
     BOOST_CHECK_MESSAGE(buffer.str() == "Unknown", "Error output TransactionException::StackUnderflow");
     buffer.str(std::string());
@@ -145,6 +149,8 @@ BOOST_AUTO_TEST_CASE(toTransactionExceptionConvert)
     BOOST_CHECK_MESSAGE(toTransactionException(oosEx) == TransactionException::OutOfStack, "OutOfStack !=> TransactionException");
     StackUnderflow stackEx;
     BOOST_CHECK_MESSAGE(toTransactionException(stackEx) == TransactionException::StackUnderflow, "StackUnderflow !=> TransactionException");
+    StepLimitReached stepEx;
+    BOOST_CHECK_MESSAGE(toTransactionException(stepEx) == TransactionException::StepLimitReached, "StepLimitReached !=> TransactionException");
     Exception notEx;
     BOOST_CHECK_MESSAGE(toTransactionException(notEx) == TransactionException::Unknown, "Unexpected should be TransactionException::Unknown");
 }
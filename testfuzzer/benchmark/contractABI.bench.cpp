@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+#include <libfuzzer/ContractABI.h>
+
+using namespace fuzzer;
+using namespace std;
+
+/* A mix of static, dynamic and array parameters */
+static string BENCH_ABI = "["
+  "{\"constant\":false,\"inputs\":[{\"name\":\"a\",\"type\":\"address\"},{\"name\":\"b\",\"type\":\"uint256\"}],\"name\":\"transfer\",\"outputs\":[],\"payable\":false,\"type\":\"function\"},"
+  "{\"constant\":false,\"inputs\":[{\"name\":\"a\",\"type\":\"string\"},{\"name\":\"b\",\"type\":\"bytes\"}],\"name\":\"setName\",\"outputs\":[],\"payable\":false,\"type\":\"function\"},"
+  "{\"constant\":false,\"inputs\":[{\"name\":\"a\",\"type\":\"uint256[]\"},{\"name\":\"b\",\"type\":\"address[3]\"}],\"name\":\"batch\",\"outputs\":[],\"payable\":true,\"type\":\"function\"},"
+  "{\"constant\":false,\"inputs\":[{\"name\":\"a\",\"type\":\"bytes32[2][]\"}],\"name\":\"matrix\",\"outputs\":[],\"payable\":false,\"type\":\"function\"},"
+  "{\"inputs\":[{\"name\":\"a\",\"type\":\"uint8\"}],\"payable\":false,\"type\":\"constructor\"}"
+"]";
+
+static void BM_ContractABIParse(benchmark::State& state) {
+  for (auto _ : state) {
+    ContractABI ca(BENCH_ABI);
+    benchmark::DoNotOptimize(ca.fds.data());
+  }
+}
+BENCHMARK(BM_ContractABIParse);
+
+static void BM_ContractABIDecode(benchmark::State& state) {
+  ContractABI ca(BENCH_ABI);
+  auto data = ca.randomTestcase();
+  for (auto _ : state) {
+    ca.updateTestData(data);
+    benchmark::DoNotOptimize(ca.decodeAccounts());
+    benchmark::DoNotOptimize(ca.decodeBlock());
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_ContractABIDecode);
+
+static void BM_ContractABIEncode(benchmark::State& state) {
+  ContractABI ca(BENCH_ABI);
+  ca.updateTestData(ca.randomTestcase());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ca.encodeConstructor());
+    benchmark::DoNotOptimize(ca.encodeFunctions());
+  }
+}
+BENCHMARK(BM_ContractABIEncode);
+
+static void BM_PostprocessTestData(benchmark::State& state) {
+  ContractABI ca(BENCH_ABI);
+  auto data = ca.randomTestcase();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ContractABI::postprocessTestData(data));
+  }
+}
+BENCHMARK(BM_PostprocessTestData);
@@ -0,0 +1,47 @@
+pragma solidity ^0.4.24;
+
+contract Crowdsale {
+  address beneficiary;
+  uint256 goal;
+  uint256 deadline;
+  uint256 raised;
+  uint256 price;
+  mapping (address => uint256) contributions;
+  bool closed;
+
+  constructor(uint256 _goal, uint256 _duration, uint256 _price) public {
+    require(_price > 0);
+    beneficiary = msg.sender;
+    goal = _goal;
+    deadline = now + _duration;
+    price = _price;
+  }
+
+  function buy(uint256 _amount) public payable {
+    require(!closed);
+    require(now <= deadline);
+    require(msg.value >= _amount * price);
+    if (_amount > 100) {
+      require(msg.value > 1 ether);
+    }
+    contributions[msg.sender] += msg.value;
+    raised += msg.value;
+  }
+
+  function close() public {
+    require(now > deadline);
+    if (raised >= goal) {
+      closed = true;
+      beneficiary.transfer(raised);
+    }
+  }
+
+  function refund() public {
+    require(now > deadline && raised < goal);
+    uint256 amount = contributions[msg.sender];
+    if (amount > 0) {
+      contributions[msg.sender] = 0;
+      msg.sender.transfer(amount);
+    }
+  }
+}
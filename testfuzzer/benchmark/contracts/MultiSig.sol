@@ -0,0 +1,58 @@
+pragma solidity ^0.4.24;
+
+contract MultiSig {
+  struct Transaction {
+    address to;
+    uint256 value;
+    uint256 confirmations;
+    bool executed;
+  }
+  mapping (address => bool) isOwner;
+  mapping (uint256 => mapping (address => bool)) confirmed;
+  Transaction[] transactions;
+  uint256 required;
+
+  constructor(address _a, address _b, uint256 _required) public payable {
+    require(_required > 0 && _required <= 3);
+    isOwner[msg.sender] = true;
+    isOwner[_a] = true;
+    isOwner[_b] = true;
+    required = _required;
+  }
+
+  function submit(address _to, uint256 _value) public returns (uint256) {
+    require(isOwner[msg.sender]);
+    transactions.push(Transaction(_to, _value, 0, false));
+    return transactions.length - 1;
+  }
+
+  function confirm(uint256 _id) public {
+    require(isOwner[msg.sender]);
+    require(_id < transactions.length);
+    require(!confirmed[_id][msg.sender]);
+    confirmed[_id][msg.sender] = true;
+    transactions[_id].confirmations += 1;
+  }
+
+  function revoke(uint256 _id) public {
+    require(_id < transactions.length);
+    if (confirmed[_id][msg.sender]) {
+      confirmed[_id][msg.sender] = false;
+      transactions[_id].confirmations -= 1;
+    }
+  }
+
+  function execute(uint256 _id) public {
+    require(_id < transactions.length);
+    Transaction storage t = transactions[_id];
+    require(!t.executed);
+    if (t.confirmations >= required) {
+      t.executed = true;
+      if (!t.to.call.value(t.value)()) {
+        t.executed = false;
+      }
+    }
+  }
+
+  function() public payable {}
+}
@@ -0,0 +1,55 @@
+pragma solidity ^0.4.24;
+
+contract Token {
+  mapping (address => uint256) balances;
+  mapping (address => mapping (address => uint256)) allowed;
+  uint256 public totalSupply;
+  address owner;
+  bool paused;
+
+  constructor(uint256 _supply) public {
+    owner = msg.sender;
+    totalSupply = _supply;
+    balances[msg.sender] = _supply;
+  }
+
+  function pause(bool _paused) public {
+    require(msg.sender == owner);
+    paused = _paused;
+  }
+
+  function transfer(address _to, uint256 _value) public returns (bool) {
+    require(!paused);
+    require(_to != address(0));
+    if (balances[msg.sender] >= _value && _value > 0) {
+      balances[msg.sender] -= _value;
+      balances[_to] += _value;
+      return true;
+    }
+    return false;
+  }
+
+  function approve(address _spender, uint256 _value) public returns (bool) {
+    require(_value == 0 || allowed[msg.sender][_spender] == 0);
+    allowed[msg.sender][_spender] = _value;
+    return true;
+  }
+
+  function transferFrom(address _from, address _to, uint256 _value) public returns (bool) {
+    require(!paused);
+    if (balances[_from] >= _value && allowed[_from][msg.sender] >= _value && _value > 0) {
+      balances[_to] += _value;
+      balances[_from] -= _value;
+      allowed[_from][msg.sender] -= _value;
+      return true;
+    }
+    return false;
+  }
+
+  function mint(address _to, uint256 _amount) public {
+    require(msg.sender == owner);
+    require(_amount < 1000000);
+    totalSupply += _amount;
+    balances[_to] += _amount;
+  }
+}
@@ -0,0 +1,126 @@
+#include <benchmark/benchmark.h>
+#include <libfuzzer/Fuzzer.h>
+#include <libfuzzer/BytecodeBranch.h>
+#include <libfuzzer/Dictionary.h>
+#include <libfuzzer/Logger.h>
+#include <fuzzer/Utils.h>
+
+using namespace fuzzer;
+using namespace std;
+
+using ValidJumpis = tuple<unordered_set<uint64_t>, unordered_set<uint64_t>>;
+
+static const unsigned BENCH_SEED = 0x5eed;
+
+/* Bundled contract compiled by solc at build time */
+struct BenchContract {
+  ContractInfo info;
+  ContractABI ca;
+  bytes bin;
+  ValidJumpis validJumpis;
+  bool loaded = false;
+};
+
+static BenchContract loadBenchContract(string name) {
+  BenchContract contract;
+  string sourceFile = string(BENCH_CONTRACTS_DIR) + name + ".sol";
+  string jsonFile = sourceFile + ".json";
+  if (!exists(jsonFile)) return contract;
+  fuzzer::Logger::enabled = false;
+  contract.info = parseSource(sourceFile, jsonFile, name, true);
+  contract.ca = ContractABI(contract.info.abiJson);
+  contract.bin = fromHex(contract.info.bin);
+  contract.validJumpis = BytecodeBranch(contract.info).findValidJumpis();
+  contract.loaded = true;
+  return contract;
+}
+
+static void BM_TargetExecutiveExec(benchmark::State& state, string name) {
+  auto contract = loadBenchContract(name);
+  if (!contract.loaded) {
+    state.SkipWithError("contract is not compiled, solc was not found at configure time");
+    return;
+  }
+  TargetContainer container;
+  auto executive = container.loadContract(contract.bin, contract.ca);
+  auto data = ContractABI::postprocessTestData(contract.ca.randomTestcase());
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(executive.exec(data, contract.validJumpis));
+  }
+  state.counters["execs"] = benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+}
+BENCHMARK_CAPTURE(BM_TargetExecutiveExec, token, string("Token"));
+BENCHMARK_CAPTURE(BM_TargetExecutiveExec, multisig, string("MultiSig"));
+BENCHMARK_CAPTURE(BM_TargetExecutiveExec, crowdsale, string("Crowdsale"));
+
+static void BM_SaveIfInterest(benchmark::State& state, string name) {
+  auto contract = loadBenchContract(name);
+  if (!contract.loaded) {
+    state.SkipWithError("contract is not compiled, solc was not found at configure time");
+    return;
+  }
+  FuzzParam fuzzParam;
+  fuzzParam.contractInfo = {contract.info};
+  Fuzzer fuzzer(fuzzParam);
+  TargetContainer container;
+  auto executive = container.loadContract(contract.bin, contract.ca);
+  auto data = contract.ca.randomTestcase();
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fuzzer.saveIfInterest(executive, data, 0, contract.validJumpis));
+  }
+}
+BENCHMARK_CAPTURE(BM_SaveIfInterest, token, string("Token"));
+BENCHMARK_CAPTURE(BM_SaveIfInterest, multisig, string("MultiSig"));
+BENCHMARK_CAPTURE(BM_SaveIfInterest, crowdsale, string("Crowdsale"));
+
+/*
+ * End-to-end: run state.range(0) havoc executions from a fixed seed and report
+ * the reached branch coverage and the execution speed. Run with
+ * --benchmark_out=bench.json --benchmark_out_format=json to track the trend
+ */
+static void BM_Campaign(benchmark::State& state, string name) {
+  auto contract = loadBenchContract(name);
+  if (!contract.loaded) {
+    state.SkipWithError("contract is not compiled, solc was not found at configure time");
+    return;
+  }
+  uint64_t numExecs = state.range(0);
+  auto totalBranches = (get<0>(contract.validJumpis).size() + get<1>(contract.validJumpis).size()) * 2;
+  double coverage = 0;
+  uint64_t totalExecs = 0;
+  for (auto _ : state) {
+    srandom(BENCH_SEED);
+    FuzzParam fuzzParam;
+    fuzzParam.contractInfo = {contract.info};
+    Fuzzer fuzzer(fuzzParam);
+    TargetContainer container;
+    Dictionary codeDict, addressDict;
+    codeDict.fromCode(contract.bin);
+    auto executive = container.loadContract(contract.bin, contract.ca);
+    vector<bytes> corpus = {contract.ca.randomTestcase()};
+    unordered_set<string> covered;
+    uint64_t execs = 0;
+    OnMutateFunc cb = [&](bytes data) {
+      /* The rest of the havoc round is mutated but not executed */
+      if (execs >= numExecs) return FuzzItem(data);
+      auto item = fuzzer.saveIfInterest(executive, data, 0, contract.validJumpis);
+      execs ++;
+      bool isNew = false;
+      for (auto tracebit : item.res.tracebits) isNew = covered.insert(tracebit).second || isNew;
+      if (isNew) corpus.push_back(item.data);
+      return item;
+    };
+    while (execs < numExecs) {
+      FuzzItem item(corpus[UR(corpus.size())]);
+      Mutation mutation(item, make_tuple(codeDict, addressDict));
+      mutation.havoc(cb);
+    }
+    totalExecs += execs;
+    coverage = totalBranches ? (double) covered.size() / totalBranches : 0;
+  }
+  state.counters["coverage"] = coverage;
+  state.counters["execsPerSecond"] = benchmark::Counter(totalExecs, benchmark::Counter::kIsRate);
+}
+BENCHMARK_CAPTURE(BM_Campaign, token, string("Token"))->Arg(2000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Campaign, multisig, string("MultiSig"))->Arg(2000)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Campaign, crowdsale, string("Crowdsale"))->Arg(2000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+#include <libfuzzer/Mutation.h>
+#include <libfuzzer/Dictionary.h>
+
+using namespace fuzzer;
+using namespace std;
+
+static const unsigned BENCH_SEED = 0x5eed;
+
+static Dicts benchDicts() {
+  Dictionary codeDict, addressDict;
+  codeDict.fromCode(fromHex("6080604052600436106100565763ffffffff7c0100000000000000000000000000000000000000000000000000000000600035041663a9059cbb811461005b575b600080fd5b"));
+  addressDict.fromAddress(Address(0xf0).asBytes());
+  addressDict.fromAddress(Address(0xf1).asBytes());
+  return make_tuple(codeDict, addressDict);
+}
+
+static FuzzItem benchItem(uint64_t size) {
+  bytes data(size, 0);
+  for (uint64_t i = 0; i < size; i ++) data[i] = i * 31;
+  return FuzzItem(data);
+}
+
+/* Measure the cost of the stage itself, the callback does not execute anything */
+template <void (Mutation::*Stage)(OnMutateFunc)>
+static void BM_MutationStage(benchmark::State& state) {
+  auto dicts = benchDicts();
+  auto item = benchItem(state.range(0));
+  uint64_t execs = 0;
+  OnMutateFunc cb = [&](bytes data) {
+    execs ++;
+    benchmark::DoNotOptimize(data.data());
+    return FuzzItem(data);
+  };
+  srandom(BENCH_SEED);
+  for (auto _ : state) {
+    Mutation mutation(item, dicts);
+    (mutation.*Stage)(cb);
+  }
+  state.counters["mutants"] = benchmark::Counter(execs, benchmark::Counter::kIsRate);
+}
+
+BENCHMARK_TEMPLATE(BM_MutationStage, &Mutation::singleWalkingBit)->Arg(384);
+BENCHMARK_TEMPLATE(BM_MutationStage, &Mutation::twoWalkingBit)->Arg(384);
+BENCHMARK_TEMPLATE(BM_MutationStage, &Mutation::fourWalkingBit)->Arg(384);
+BENCHMARK_TEMPLATE(BM_MutationStage, &Mutation::singleWalkingByte)->Arg(384);
+BENCHMARK_TEMPLATE(BM_MutationStage, &Mutation::twoWalkingByte)->Arg(384);
+BENCHMARK_TEMPLATE(BM_MutationStage, &Mutation::fourWalkingByte)->Arg(384);
+BENCHMARK_TEMPLATE(BM_MutationStage, &Mutation::singleArith)->Arg(384);
+BENCHMARK_TEMPLATE(BM_MutationStage, &Mutation::twoArith)->Arg(384);
+BENCHMARK_TEMPLATE(BM_MutationStage, &Mutation::fourArith)->Arg(384);
+BENCHMARK_TEMPLATE(BM_MutationStage, &Mutation::singleInterest)->Arg(384);
+BENCHMARK_TEMPLATE(BM_MutationStage, &Mutation::twoInterest)->Arg(384);
+BENCHMARK_TEMPLATE(BM_MutationStage, &Mutation::fourInterest)->Arg(384);
+BENCHMARK_TEMPLATE(BM_MutationStage, &Mutation::overwriteWithDictionary)->Arg(384);
+BENCHMARK_TEMPLATE(BM_MutationStage, &Mutation::overwriteWithAddressDictionary)->Arg(384);
+BENCHMARK_TEMPLATE(BM_MutationStage, &Mutation::havoc)->Arg(384);
+
+static void BM_MutationSplice(benchmark::State& state) {
+  auto dicts = benchDicts();
+  vector<FuzzItem> items;
+  for (int i = 0; i < state.range(0); i ++) {
+    auto item = benchItem(384);
+    item.data[i % 384] ^= 0xff;
+    item.res.cksum = i;
+    items.push_back(item);
+  }
+  srandom(BENCH_SEED);
+  for (auto _ : state) {
+    Mutation mutation(items[0], dicts);
+    benchmark::DoNotOptimize(mutation.splice(items.size(), [&](size_t idx) { return items[idx]; }));
+  }
+}
+BENCHMARK(BM_MutationSplice)->Arg(16)->Arg(256);
@@ -0,0 +1,41 @@
+#include <benchmark/benchmark.h>
+#include <liboracle/OracleFactory.h>
+
+using namespace std;
+
+/* One root call followed by a typical mix of recorded opcodes */
+static void saveFunction(OracleFactory &factory, int numOpcodes) {
+  static const Instruction insts[] = {
+    Instruction::ADD, Instruction::SUB, Instruction::TIMESTAMP, Instruction::NUMBER, Instruction::CALL
+  };
+  OpcodePayload root;
+  root.inst = Instruction::CALL;
+  root.data = bytes(68, 1);
+  root.caller = Address(0xf0);
+  root.callee = Address(0xf1);
+  factory.save(OpcodeContext(0, root));
+  for (int i = 0; i < numOpcodes; i ++) {
+    OpcodePayload payload;
+    payload.pc = i;
+    payload.inst = insts[i % 5];
+    if (payload.inst == Instruction::CALL) {
+      payload.gas = 2300;
+      payload.wei = 1;
+      payload.caller = Address(0xf1);
+      payload.callee = Address(0xf0);
+    }
+    factory.save(OpcodeContext(1, payload));
+  }
+  factory.finalize();
+}
+
+/* Oracles run while contexts are saved, so the dispatch is what costs */
+static void BM_OracleFactoryDispatch(benchmark::State& state) {
+  OracleFactory factory;
+  for (auto _ : state) {
+    factory.initialize();
+    for (int i = 0; i < 16; i ++) saveFunction(factory, state.range(0));
+    benchmark::DoNotOptimize(factory.analyze());
+  }
+}
+BENCHMARK(BM_OracleFactoryDispatch)->Arg(64)->Arg(1024);
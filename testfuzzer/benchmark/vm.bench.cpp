@@ -0,0 +1,38 @@
+#include <benchmark/benchmark.h>
+#include <libfuzzer/TargetProgram.h>
+#include <libfuzzer/Util.h>
+#include <libevm/VMFactory.h>
+
+using namespace fuzzer;
+using namespace std;
+
+/* CALL(gas, address, 0, 0, 0, 0, 0) into itself, reentering until gas or depth runs out */
+static const string REENTRANT_CODE = "6000" "6000" "6000" "6000" "6000" "30" "5a" "f1" "00";
+
+/*
+ * Every transaction reenters far past the depth where calls leave the thread stack,
+ * so this measures how much switching to the offloaded stack costs
+ */
+static void BM_ReentrantCall(benchmark::State& state) {
+  TargetProgram program(nullptr);
+  program.deploy(Address(CONTRACT_ADDRESS), fromHex(REENTRANT_CODE));
+  program.setStepLimit(0);
+  for (auto _ : state) {
+    program.setGas(state.range(0));
+    benchmark::DoNotOptimize(program.invoke(Address(CONTRACT_ADDRESS), CONTRACT_FUNCTION, bytes(), false, EMPTY_ONOP));
+  }
+  state.counters["execs"] = benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_ReentrantCall)->Arg(1000000)->Arg(50000000)->Unit(benchmark::kMicrosecond);
+
+/* VMs of state.range(0) nested frames taken and given back, as a call chain of that depth does */
+static void BM_VMFactoryCreate(benchmark::State& state) {
+  vector<VMPtr> frames;
+  for (auto _ : state) {
+    for (int i = 0; i < state.range(0); i ++) frames.push_back(VMFactory::create());
+    benchmark::DoNotOptimize(frames.data());
+    while (frames.size()) frames.pop_back();
+  }
+  state.counters["frames"] = benchmark::Counter(state.iterations() * state.range(0), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_VMFactoryCreate)->Arg(1)->Arg(64);
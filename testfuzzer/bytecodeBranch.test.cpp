@@ -0,0 +1,47 @@
+#include <iostream>
+
+#include "gtest/gtest.h"
+#include <libfuzzer/BytecodeBranch.h>
+
+using namespace fuzzer;
+using namespace std;
+
+TEST(BytecodeBranch, findFunctionReach)
+{
+  /*
+   * 0xaabbccdd stores a value, 0x11223344 calls an internal function
+   * with a JUMPI at pc 43 and returns through a dynamic jump
+   */
+  auto code = fromHex(
+    "600035" "8063aabbccdd14601857" "80631122334414601f57" "00"
+    "5b6001600055" "00"
+    "5b6025602756" "5b00"
+    "5b34602d5756" "5b56"
+  );
+  auto reaches = BytecodeBranch::findFunctionReach(code);
+  EXPECT_EQ(reaches.size(), 2);
+  auto store = reaches[0xaabbccdd];
+  EXPECT_TRUE(store.known);
+  EXPECT_TRUE(store.writesState);
+  EXPECT_TRUE(store.jumpis.empty());
+  auto call = reaches[0x11223344];
+  EXPECT_TRUE(call.known);
+  EXPECT_FALSE(call.writesState);
+  EXPECT_EQ(call.jumpis, unordered_set<uint64_t>({ 43 }));
+  EXPECT_FALSE(reaches.count(0xdeadbeef));
+}
+
+TEST(BytecodeBranch, bytecodeOnly)
+{
+  /* Same contract without source maps: dispatcher JUMPIs are not branches */
+  ContractInfo contractInfo;
+  contractInfo.binRuntime =
+    "600035" "8063aabbccdd14601857" "80631122334414601f57" "00"
+    "5b6001600055" "00"
+    "5b6025602756" "5b00"
+    "5b34602d5756" "5b56";
+  contractInfo.bin = contractInfo.binRuntime;
+  auto validJumpis = BytecodeBranch(contractInfo).findValidJumpis();
+  EXPECT_TRUE(get<0>(validJumpis).empty());
+  EXPECT_EQ(get<1>(validJumpis), unordered_set<uint64_t>({ 43 }));
+}
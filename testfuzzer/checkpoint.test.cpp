@@ -0,0 +1,63 @@
+#include <iostream>
+#include <boost/filesystem.hpp>
+
+#include "gtest/gtest.h"
+#include <libfuzzer/Checkpoint.h>
+
+using namespace fuzzer;
+using namespace std;
+
+TEST(Checkpoint, roundTrip)
+{
+  CheckpointWriter w;
+  w.u64(0x1122334455667788);
+  w.real(0.25);
+  w.word(u256(1) << 200);
+  w.data(bytes({ 1, 2, 3 }));
+  w.strings(vector<string>({ "12:34", "gas:0" }));
+  auto file = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("checkpoint.test.%%%%%%%%")).string();
+  EXPECT_TRUE(writeCheckpoint(file, w.out()));
+  bytes data;
+  EXPECT_TRUE(readCheckpoint(file, data));
+  boost::filesystem::remove(file);
+  EXPECT_EQ(data, w.out());
+  CheckpointReader r(data);
+  EXPECT_EQ(r.u64(), 0x1122334455667788);
+  EXPECT_EQ(r.real(), 0.25);
+  EXPECT_EQ(r.word(), u256(1) << 200);
+  EXPECT_EQ(r.data(), bytes({ 1, 2, 3 }));
+  EXPECT_EQ(r.strings(), vector<string>({ "12:34", "gas:0" }));
+  EXPECT_TRUE(r.good());
+  /* Nothing is left */
+  EXPECT_EQ(r.u64(), 0u);
+  EXPECT_FALSE(r.good());
+}
+
+TEST(Checkpoint, truncated)
+{
+  CheckpointWriter w;
+  w.data(bytes(100, 7));
+  auto data = w.out();
+  data.resize(50);
+  CheckpointReader r(data);
+  EXPECT_EQ(r.data(), bytes());
+  EXPECT_FALSE(r.good());
+}
+
+TEST(Checkpoint, count)
+{
+  CheckpointWriter w;
+  w.u64(2);
+  w.u64(7);
+  w.u64(8);
+  w.u64(1ull << 60);
+  auto data = w.out();
+  CheckpointReader r(data);
+  EXPECT_EQ(r.count(), 2u);
+  EXPECT_EQ(r.u64(), 7u);
+  EXPECT_EQ(r.u64(), 8u);
+  EXPECT_EQ(r.remaining(), 8u);
+  /* More elements than bytes left */
+  EXPECT_EQ(r.count(), 0u);
+  EXPECT_FALSE(r.good());
+}
@@ -0,0 +1,82 @@
+#include <iostream>
+#include <boost/filesystem.hpp>
+
+#include "gtest/gtest.h"
+#include <libfuzzer/CombinedJson.h>
+
+using namespace fuzzer;
+using namespace std;
+
+static const string COMBINED_JSON = R"({
+  "contracts": {
+    "Other.sol:Other": { "abi": "[]", "bin": "00" },
+    "Token.sol:Token": {
+      "abi": "[{\"constant\":true,\"name\":\"balance\"}]",
+      "bin": "6080",
+      "bin-runtime": "60",
+      "srcmap": "0:10:0:-",
+      "srcmap-runtime": "1:2:0:-"
+    }
+  },
+  "sourceList": ["Token.sol"],
+  "sources": {
+    "Token.sol": {
+      "AST": {
+        "attributes": { "absolutePath": "Token.sol" },
+        "children": [{
+          "children": [
+            { "attributes": { "constant": true, "name": "balance" }, "name": "FunctionDefinition", "src": "20:30:0" },
+            { "src": "60:10:0", "name": "FunctionDefinition", "children": [], "attributes": { "name": "set", "constant": false } },
+            { "attributes": { "constant": true, "name": "x" }, "name": "VariableDeclaration", "src": "80:5:0" }
+          ],
+          "name": "ContractDefinition",
+          "src": "0:100:0"
+        }],
+        "name": "SourceUnit",
+        "src": "0:100:0"
+      }
+    }
+  },
+  "version": "0.4.24"
+})";
+
+TEST(CombinedJson, read)
+{
+  ContractInfo info;
+  EXPECT_TRUE(CombinedJson(COMBINED_JSON).read("Token", info));
+  EXPECT_EQ(info.contractName, "Token.sol:Token");
+  EXPECT_EQ(info.abiJson, "[{\"constant\":true,\"name\":\"balance\"}]");
+  EXPECT_EQ(info.bin, "6080");
+  EXPECT_EQ(info.binRuntime, "60");
+  EXPECT_EQ(info.srcmap, "0:10:0:-");
+  EXPECT_EQ(info.srcmapRuntime, "1:2:0:-");
+  EXPECT_EQ(info.constantFunctionSrcmap, vector<string>({ "20:30:0" }));
+  EXPECT_TRUE(CombinedJson(COMBINED_JSON).read("Missing", info));
+  EXPECT_EQ(info.contractName, "");
+  EXPECT_FALSE(CombinedJson(COMBINED_JSON.substr(0, 200)).read("Token", info));
+  /* Malformed escapes fail the parse */
+  EXPECT_FALSE(CombinedJson(R"({"contracts": {"T.sol:T": {"abi": "\uzz12"}}})").read("T", info));
+  EXPECT_FALSE(CombinedJson(R"({"contracts": {"T.sol:T": {"abi": "\u12"}}})").read("T", info));
+}
+
+TEST(CombinedJson, cache)
+{
+  auto cacheFile = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("combinedJson.test.%%%%%%%%")).string();
+  ContractInfo info;
+  ContractInfo cached;
+  CombinedJson(COMBINED_JSON).read("Token", info);
+  saveContractCache(cacheFile, 42, "Token", info);
+  EXPECT_FALSE(loadContractCache(cacheFile, 43, "Token", cached));
+  EXPECT_FALSE(loadContractCache(cacheFile, 42, "Other", cached));
+  EXPECT_TRUE(loadContractCache(cacheFile, 42, "Token", cached));
+  EXPECT_EQ(cached.contractName, info.contractName);
+  EXPECT_EQ(cached.abiJson, info.abiJson);
+  EXPECT_EQ(cached.bin, info.bin);
+  EXPECT_EQ(cached.srcmapRuntime, info.srcmapRuntime);
+  EXPECT_EQ(cached.constantFunctionSrcmap, info.constantFunctionSrcmap);
+  /* A truncated cache is rejected */
+  auto size = boost::filesystem::file_size(cacheFile);
+  boost::filesystem::resize_file(cacheFile, size - 4);
+  EXPECT_FALSE(loadContractCache(cacheFile, 42, "Token", cached));
+  boost::filesystem::remove(cacheFile);
+}
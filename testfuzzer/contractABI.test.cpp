@@ -164,3 +164,35 @@ TEST(ContractABI, DISABLED_encodeSingle)
   EXPECT_EQ(ca.encodeSingle(ll).size(), 96);
 }
 
+
+static DeployedContract deployedContract(string name, Address addr) {
+  DeployedContract contract;
+  contract.name = name;
+  contract.addr = addr;
+  return contract;
+}
+
+TEST(ContractABI, wireConstructor)
+{
+  string json = "[{\"inputs\":[{\"name\":\"_token\",\"type\":\"address\"},{\"name\":\"n\",\"type\":\"uint256\"},{\"name\":\"owner\",\"type\":\"address\"},{\"name\":\"feed\",\"type\":\"address\",\"internalType\":\"contract PriceOracle\"}],\"payable\":false,\"stateMutability\":\"nonpayable\",\"type\":\"constructor\"}]";
+  ContractABI ca(json);
+  ca.updateTestData(bytes(256, 0));
+  ca.wireConstructor({ deployedContract("PriceOracle", Address(0x100)), deployedContract("Token", Address(0x101)) });
+  auto encoded = ca.encodeConstructor();
+  EXPECT_EQ(encoded.size(), 128u);
+  /* By name, by declared contract, an argument nothing matches stays as it is */
+  EXPECT_EQ(toHex(bytes(encoded.begin(), encoded.begin() + 32)), string(61, '0') + "101");
+  EXPECT_EQ(bytes(encoded.begin() + 32, encoded.begin() + 96), bytes(64, 0));
+  EXPECT_EQ(toHex(bytes(encoded.begin() + 96, encoded.end())), string(61, '0') + "100");
+}
+
+TEST(ContractABI, wireConstructorOnce)
+{
+  string json = "[{\"inputs\":[{\"name\":\"tokenA\",\"type\":\"address\"},{\"name\":\"tokenB\",\"type\":\"address\"}],\"payable\":false,\"stateMutability\":\"nonpayable\",\"type\":\"constructor\"}]";
+  ContractABI ca(json);
+  ca.updateTestData(bytes(192, 0));
+  ca.wireConstructor({ deployedContract("Token", Address(0x100)) });
+  auto encoded = ca.encodeConstructor();
+  EXPECT_EQ(toHex(bytes(encoded.begin(), encoded.begin() + 32)), string(61, '0') + "100");
+  EXPECT_EQ(bytes(encoded.begin() + 32, encoded.end()), bytes(32, 0));
+}
@@ -0,0 +1,33 @@
+#include <iostream>
+#include <boost/filesystem.hpp>
+
+#include "gtest/gtest.h"
+#include <libfuzzer/TargetProgram.h>
+#include <libfuzzer/Util.h>
+
+using namespace fuzzer;
+using namespace std;
+
+TEST(ForkSource, openDB)
+{
+  auto path = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("fork.test.%%%%%%%%");
+  Address account(0x1234);
+  h256 root;
+  {
+    /* A chain database holding one account */
+    ForkSource source(path.string(), h256());
+    State state(0, source.db, BaseState::Empty);
+    state.addBalance(account, 1000);
+    state.commit(State::CommitBehaviour::KeepEmptyAccounts);
+    state.db().commit();
+    root = state.rootHash();
+    EXPECT_FALSE(source.hasRoot());
+  }
+  {
+    ForkSource source(path.string(), root);
+    EXPECT_TRUE(source.hasRoot());
+    TargetProgram program(&source);
+    EXPECT_EQ(program.getBalance(account), 1000);
+  }
+  boost::filesystem::remove_all(path);
+}
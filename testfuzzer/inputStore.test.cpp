@@ -0,0 +1,59 @@
+#include <iostream>
+#include <boost/filesystem.hpp>
+
+#include "gtest/gtest.h"
+#include <libfuzzer/InputStore.h>
+
+using namespace fuzzer;
+using namespace std;
+
+static void checkStore(InputStore &store) {
+  auto first = store.add(bytes(100, 1));
+  auto second = store.add(bytes(50, 2));
+  EXPECT_EQ(store.add(bytes(100, 1)), first);
+  EXPECT_NE(first, second);
+  EXPECT_EQ(store.size(), 150u);
+  /* Grow past the first mapping */
+  for (int i = 0; i < 1000; i ++) {
+    bytes data(100, 3);
+    data.push_back(i % 256);
+    data.push_back(i / 256);
+    store.add(data);
+  }
+  EXPECT_EQ(store.get(first), bytes(100, 1));
+  EXPECT_EQ(store.get(second), bytes(50, 2));
+}
+
+TEST(InputStore, memory)
+{
+  InputStore store;
+  checkStore(store);
+}
+
+TEST(InputStore, file)
+{
+  /* The store file is private and already unlinked, nothing is left in the directory */
+  InputStore store;
+  store.open(boost::filesystem::temp_directory_path().string());
+  checkStore(store);
+}
+
+TEST(InputStore, release)
+{
+  InputStore store;
+  auto first = store.add(bytes(100, 1));
+  auto second = store.add(bytes(50, 2));
+  store.add(bytes(10, 3));
+  /* Shared inputs stay until the last reference is gone */
+  store.add(bytes(100, 1));
+  store.release(first);
+  EXPECT_EQ(store.get(first), bytes(100, 1));
+  store.release(first);
+  store.release(second);
+  EXPECT_EQ(store.size(), 10u);
+  /* Freed neighbours are merged and reused */
+  auto reused = store.add(bytes(120, 4));
+  EXPECT_EQ(reused.offset, first.offset);
+  EXPECT_EQ(store.get(reused), bytes(120, 4));
+  EXPECT_EQ(store.size(), 130u);
+}
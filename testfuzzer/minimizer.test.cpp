@@ -0,0 +1,46 @@
+#include <iostream>
+
+#include "gtest/gtest.h"
+#include <libfuzzer/Minimizer.h>
+
+using namespace fuzzer;
+using namespace std;
+
+TEST(Minimizer, minimize)
+{
+  bytes data(4 * 32, 0xff);
+  Minimizer minimizer;
+  auto minimized = minimizer.minimize(data, [](const bytes &d) { return d[40] == 0xff; });
+  bytes expected(4 * 32, 0);
+  expected[40] = 0xff;
+  EXPECT_EQ(minimized, expected);
+  /* 4 words, then 32 bytes of the word which stayed */
+  EXPECT_EQ(minimizer.execs, 36u);
+}
+
+TEST(Minimizer, maxExecs)
+{
+  bytes data(4 * 32, 0xff);
+  Minimizer minimizer(2);
+  auto minimized = minimizer.minimize(data, [](const bytes &) { return false; });
+  EXPECT_EQ(minimized, data);
+  EXPECT_EQ(minimizer.execs, 2u);
+}
+
+TEST(Minimizer, trim)
+{
+  /* One dynamic value of 64 bytes, only its length has to stay above 2 */
+  bytes data(7 * 32, 0x11);
+  data[0] = 64;
+  Minimizer minimizer;
+  auto trimmed = minimizer.trim(data, [](const bytes &d) { return d[0] > 2; });
+  EXPECT_EQ(trimmed[0], 4);
+  EXPECT_EQ(trimmed.size(), 3u * 32);
+  EXPECT_TRUE(all_of(trimmed.begin() + 1, trimmed.end(), [](byte b) { return !b; }));
+}
+
+TEST(Minimizer, cover)
+{
+  vector<vector<uint32_t>> sets = { { 1, 2 }, { 1, 2, 3 }, { 4 }, { 3, 4 }, { 2 } };
+  EXPECT_EQ(Minimizer::cover(sets), vector<size_t>({ 1, 2 }));
+}
@@ -7,3 +7,102 @@
 
 using namespace fuzzer;
 using namespace std;
+
+/* Fake execution where branch 10:20 depends on the fourth word through cond */
+static FuzzItem fakeExec(bytes data, function<bool(u256)> cond, u256 constant) {
+  FuzzItem item(data);
+  auto value = fromBigEndian<u256>(bytes(data.begin() + 96, data.begin() + 128));
+  if (cond(value)) item.res.tracebits.insert("10:20");
+  else item.res.predicates["10:20"] = (value > constant ? value - constant : constant - value) + 1;
+  return item;
+}
+
+static uint64_t solveExecs(function<bool(u256)> cond, u256 constant) {
+  Dictionary codeDict, addressDict;
+  uint64_t execs = 0;
+  FuzzItem seed = fakeExec(bytes(6 * 32, 0), cond, constant);
+  Mutation mutation(seed, make_tuple(codeDict, addressDict));
+  auto solved = mutation.solve("10:20", [&](bytes data) {
+    execs ++;
+    return fakeExec(data, cond, constant);
+  });
+  EXPECT_TRUE(solved);
+  return execs;
+}
+
+TEST(Mutation, solveEquality) {
+  u256 constant("0x1234567890abcdef1234567890abcdef");
+  EXPECT_LT(solveExecs([&](u256 v) { return v == constant; }, constant), 20);
+}
+
+TEST(Mutation, solveRange) {
+  u256 constant("0xdeadbeef");
+  EXPECT_LT(solveExecs([&](u256 v) { return v > constant && v < constant + 100; }, constant), 20);
+}
+
+TEST(Mutation, inferInfluence) {
+  Dictionary codeDict, addressDict;
+  u256 constant("0xdeadbeef");
+  auto cond = [&](u256 v) { return v == constant; };
+  FuzzItem seed = fakeExec(bytes(6 * 32, 0), cond, constant);
+  Mutation mutation(seed, make_tuple(codeDict, addressDict));
+  auto influence = mutation.inferInfluence("10:20", [&](bytes data) { return fakeExec(data, cond, constant); });
+  ASSERT_EQ(influence.size(), 6 * 32);
+  for (int i = 0; i < 6 * 32; i ++) EXPECT_EQ(influence[i], i / 32 == 3);
+}
+
+TEST(Mutation, batch) {
+  Dictionary codeDict, addressDict;
+  FuzzItem seed(bytes(2 * 32, 0));
+  Mutation mutation(seed, make_tuple(codeDict, addressDict));
+  vector<size_t> batches;
+  mutation.setBatch([&](const vector<bytes> &batch) {
+    batches.push_back(batch.size());
+    return vector<FuzzItem>(batch.begin(), batch.end());
+  }, 48);
+  uint64_t singles = 0;
+  mutation.singleWalkingBit([&](bytes data) {
+    singles ++;
+    return FuzzItem(data);
+  });
+  /* 512 flips make ten full batches and a last one of 32 */
+  EXPECT_EQ(singles, 0);
+  ASSERT_EQ(batches.size(), 11);
+  EXPECT_EQ(batches[0], 48);
+  EXPECT_EQ(batches[10], 32);
+}
+
+TEST(AutoDictionary, addWords)
+{
+  AutoDictionary autoDict;
+  bytes memory(64, 0);
+  memory[31] = 1;
+  memory[63] = 2;
+  /* offset + size wraps around to 32 */
+  autoDict.addWords(memory, (u256(1) << 256) - 32, 64);
+  autoDict.addWords(memory, 32, (u256(1) << 256) - 1);
+  autoDict.addWords(memory, 0, 65);
+  EXPECT_EQ(autoDict.size(), 0u);
+  autoDict.addWords(memory, 0, 64);
+  EXPECT_EQ(autoDict.size(), 2u);
+}
+
+TEST(AutoDictionary, saveRestore)
+{
+  AutoDictionary autoDict;
+  autoDict.add(7);
+  autoDict.add(7);
+  autoDict.add(9, "10:20");
+  CheckpointWriter w;
+  autoDict.save(w);
+  auto data = w.out();
+  CheckpointReader r(data);
+  AutoDictionary restored;
+  restored.restore(r);
+  EXPECT_TRUE(r.good());
+  EXPECT_EQ(restored.size(), 2u);
+  auto top = restored.top("10:20", 2);
+  ASSERT_EQ(top.size(), 2u);
+  EXPECT_EQ(top[0].data, h256(9).asBytes());
+  EXPECT_EQ(top[1].data, h256(7).asBytes());
+}
@@ -0,0 +1,52 @@
+#include <iostream>
+#include <chrono>
+#include <boost/filesystem.hpp>
+
+#include "gtest/gtest.h"
+#include <libfuzzer/SyncDir.h>
+
+using namespace fuzzer;
+using namespace std;
+
+TEST(SyncDir, branchKey)
+{
+  EXPECT_EQ(SyncDir::branchKey("12:34"), (12ull << 32) | 34);
+  EXPECT_EQ(SyncDir::branchOf(SyncDir::branchKey("4096:4101")), "4096:4101");
+}
+
+/* Entries of the peers, polled until some arrive or the deadline passes */
+static vector<SyncEntry> takeWithin(SyncDir &sync, chrono::seconds timeout)
+{
+  auto deadline = chrono::steady_clock::now() + timeout;
+  vector<SyncEntry> entries;
+  while (entries.empty() && chrono::steady_clock::now() < deadline) {
+    this_thread::sleep_for(chrono::milliseconds(50));
+    entries = sync.take();
+  }
+  return entries;
+}
+
+TEST(SyncDir, exchange)
+{
+  auto root = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("syncDir.test.%%%%%%%%")).string();
+  {
+    /* Entries are written at the latest when the instance stops */
+    SyncDir main(root, "main", 1);
+    main.publish(SyncDir::branchKey("12:34"), bytes({ 1, 2, 3 }));
+  }
+  SyncDir secondary(root, "secondary", 1);
+  auto entries = takeWithin(secondary, chrono::seconds(5));
+  ASSERT_EQ(entries.size(), 1u);
+  EXPECT_EQ(entries[0].branch, SyncDir::branchKey("12:34"));
+  EXPECT_EQ(entries[0].input, bytes({ 1, 2, 3 }));
+  {
+    /* A restarted instance continues its numbering */
+    SyncDir main(root, "main", 1);
+    main.publish(SyncDir::branchKey("56:78"), bytes({ 4 }));
+  }
+  /* The round which reads the new entry does not read the first one again */
+  entries = takeWithin(secondary, chrono::seconds(5));
+  ASSERT_EQ(entries.size(), 1u);
+  EXPECT_EQ(entries[0].branch, SyncDir::branchKey("56:78"));
+  boost::filesystem::remove_all(root);
+}
@@ -27,3 +27,37 @@ TEST(Util, DISABLED_CouldBeBitflip)
 {
   EXPECT_EQ(couldBeBitflip(32), true);
 }
+
+TEST(Util, hashTracebits)
+{
+  unordered_set<string> a = { "10:20", "30:40", "50:60" };
+  unordered_set<string> b = { "50:60", "10:20", "30:40" };
+  EXPECT_EQ(hashTracebits(a), hashTracebits(b));
+  EXPECT_NE(hashTracebits(a), hashTracebits({ "10:20", "30:40" }));
+}
+
+TEST(Util, stateIndex)
+{
+  EXPECT_EQ(valueClass(0), 0);
+  EXPECT_EQ(valueClass(1), 1);
+  EXPECT_EQ(valueClass(200), 2);
+  EXPECT_EQ(valueClass(u256(1) << 100), 3);
+  EXPECT_EQ(valueClass(~u256(0)), 4);
+  EXPECT_EQ(valueClass(u256(1) << 200), 5);
+  /* Values of one class share an entry, a new class of a slot does not */
+  EXPECT_EQ(stateIndex(3, 500), stateIndex(3, 70000));
+  EXPECT_NE(stateIndex(3, 500), stateIndex(3, 0));
+  EXPECT_LT(stateIndex(3, 500), STATE_MAP_SIZE);
+  StorageHash a, b, c;
+  a.update(1, 500);
+  a.update(2, 1);
+  b.update(2, 1);
+  b.update(1, 70000);
+  c.update(1, 500);
+  EXPECT_EQ(a.index(), b.index());
+  EXPECT_NE(a.index(), c.index());
+  /* Clearing a slot takes it out again */
+  a.update(2, 0);
+  EXPECT_EQ(a.index(), c.index());
+  EXPECT_EQ(a.values.size(), 1u);
+}